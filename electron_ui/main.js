@@ -5,6 +5,9 @@ const path = require('path')
 let mainWindow
 let backendProcess
 
+// 后端在 stdin EOF 时落盘搜索缓存并输出 profile，超时仍未退出才强制结束
+const BACKEND_EXIT_TIMEOUT_MS = 5000
+
 function createWindow() {
     mainWindow = new BrowserWindow({
         width: 1200,
@@ -24,23 +27,43 @@ function createWindow() {
     mainWindow.loadFile('index.html')
 
     const exePath = path.join(__dirname, 'gomoku_core.exe')
-    backendProcess = spawn(exePath)
+    // 持久化搜索缓存放在用户数据目录，重启后热启动开局分析
+    const cachePath = path.join(app.getPath('userData'), 'search_cache.bin')
+    backendProcess = spawn(exePath, ['--cache', cachePath])
 
     backendProcess.stdout.on('data', (data) => {
         const lines = data.toString().split(/\r?\n/)
         lines.forEach(line => {
-            if (line.trim()) mainWindow.webContents.send('cpp-msg', line.trim())
+            if (line.trim() && mainWindow) mainWindow.webContents.send('cpp-msg', line.trim())
         })
     })
 
+    backendProcess.on('exit', () => {
+        backendProcess = null
+    })
+
     mainWindow.on('closed', () => {
-        if (backendProcess) backendProcess.kill()
         mainWindow = null
     })
 }
 
+function shutdownBackend(done) {
+    const proc = backendProcess
+    if (!proc) return done()
+    const timer = setTimeout(() => proc.kill(), BACKEND_EXIT_TIMEOUT_MS)
+    proc.once('exit', () => {
+        clearTimeout(timer)
+        done()
+    })
+    proc.stdin.end()
+}
+
 app.whenReady().then(createWindow)
 
+app.on('window-all-closed', () => {
+    shutdownBackend(() => app.quit())
+})
+
 ipcMain.on('window-min', (event) => {
     const win = BrowserWindow.fromWebContents(event.sender)
     if (win) win.minimize()
@@ -0,0 +1,129 @@
+// 评估原语微基准：在随机真实局面上测量 countPatternsLine / evaluate / genMoves /
+// isWin / makesFive / GomokuLogic::checkWinFrom 以及增量威胁表的 ns/call。
+// 用法: gomoku_bench [positions=2000] [seed=1]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "widget/boardEval.h"
+#include "widget/gomokuLogic.h"
+#include "tools/boardGen.h"
+
+struct Position {
+    GomokuLogic game;
+    int b[BOARD_SIZE][BOARD_SIZE];
+    ThreatMap threats;
+};
+
+static volatile long long g_sink = 0; // 防止结果被优化掉
+
+// 先预热一遍，再重复整轮直到累计耗时超过 200ms
+template <class Pass>
+static void runBench(const char* name, long long callsPerPass, Pass&& pass) {
+    using clock = std::chrono::steady_clock;
+    if (callsPerPass <= 0) { std::printf("%-18s (no calls)\n", name); return; }
+    g_sink = g_sink + pass();
+    long long calls = 0;
+    double elapsedNs = 0;
+    auto start = clock::now();
+    do {
+        g_sink = g_sink + pass();
+        calls += callsPerPass;
+        elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+    } while (elapsedNs < 2e8);
+    std::printf("%-18s %10.1f ns/call  (%lld calls)\n", name, elapsedNs / (double)calls, calls);
+}
+
+int main(int argc, char** argv) {
+    int positions = argc > 1 ? std::atoi(argv[1]) : 2000;
+    unsigned long long seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> stoneDist(4, 80);
+    std::vector<Position> pos(positions);
+    long long stones = 0, empties = 0;
+    for (auto& p : pos) {
+        stones += randomGame(rng, stoneDist(rng), p.game);
+        copyBoard(p.game, p.b);
+        p.threats.rebuild(p.b);
+    }
+    empties = (long long)positions * BOARD_SIZE * BOARD_SIZE - stones;
+    std::printf("positions=%d seed=%llu avg_stones=%.1f\n", positions, seed, positions ? (double)stones / positions : 0.0);
+
+    runBench("countPatternsLine", (long long)positions * BOARD_SIZE * 2, [&] {
+        long long s = 0;
+        for (auto& p : pos) {
+            for (int i = 0; i < BOARD_SIZE; ++i) {
+                for (int color = 1; color <= 2; ++color) {
+                    PatternCount pc;
+                    countPatternsLine(&p.b[i][0], 1, BOARD_SIZE, color, pc);
+                    s += pc.o3 + pc.b3 + pc.o2;
+                }
+            }
+        }
+        return s;
+    });
+
+    runBench("evaluate", positions, [&] {
+        long long s = 0;
+        for (auto& p : pos) s += evaluate(p.b);
+        return s;
+    });
+
+    std::vector<Move> moves;
+    runBench("genMoves", positions, [&] {
+        long long s = 0;
+        for (auto& p : pos) { genMoves(p.b, moves, 2); s += (long long)moves.size(); }
+        return s;
+    });
+
+    runBench("genMoves(map)", positions, [&] {
+        long long s = 0;
+        for (auto& p : pos) { genMoves(p.b, p.threats, 1, moves, 2, false); s += (long long)moves.size(); }
+        return s;
+    });
+
+    // 每个空位落子再提子，各触发一次增量更新
+    runBench("ThreatMap update", empties * 2, [&] {
+        long long s = 0;
+        for (auto& p : pos)
+            for (int i = 0; i < BOARD_SIZE; ++i)
+                for (int j = 0; j < BOARD_SIZE; ++j) {
+                    if (p.b[i][j] != 0) continue;
+                    p.b[i][j] = 1; p.threats.update(p.b, i, j);
+                    s += p.threats.count(1, ThreatMap::T_FOUR);
+                    p.b[i][j] = 0; p.threats.update(p.b, i, j);
+                }
+        return s;
+    });
+
+    runBench("isWin", stones, [&] {
+        long long s = 0;
+        for (auto& p : pos)
+            for (int i = 0; i < BOARD_SIZE; ++i)
+                for (int j = 0; j < BOARD_SIZE; ++j)
+                    if (p.b[i][j] != 0) s += isWin(p.b, i, j);
+        return s;
+    });
+
+    runBench("makesFive", empties * 2, [&] {
+        long long s = 0;
+        for (auto& p : pos)
+            for (int i = 0; i < BOARD_SIZE; ++i)
+                for (int j = 0; j < BOARD_SIZE; ++j)
+                    if (p.b[i][j] == 0) s += makesFive(p.b, i, j, 1) + makesFive(p.b, i, j, 2);
+        return s;
+    });
+
+    runBench("checkWinFrom", stones, [&] {
+        long long s = 0;
+        for (auto& p : pos)
+            for (int i = 0; i < BOARD_SIZE; ++i)
+                for (int j = 0; j < BOARD_SIZE; ++j)
+                    if (p.b[i][j] != 0) s += p.game.checkWinFrom(i, j);
+        return s;
+    });
+    return 0;
+}
@@ -0,0 +1,50 @@
+#ifndef MY_APP_TOOLS_BOARDGEN_H
+#define MY_APP_TOOLS_BOARDGEN_H
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "widget/gomokuLogic.h"
+
+// 随机"真实"局面生成：用 GomokuLogic 黑白交替重放，
+// 首手落在天元附近，之后每手落在某个已有棋子的 2 格邻域内（贴近实战的聚集分布）。
+// 若中途出现五连则停在终局局面；返回实际落子数。
+inline int randomGame(std::mt19937_64& rng, int stones, GomokuLogic& game) {
+    game.reset();
+    std::vector<std::pair<int, int>> placed;
+    std::uniform_int_distribution<int> offset(-2, 2);
+    while ((int)placed.size() < stones && game.state() == GomokuLogic::InProgress) {
+        bool ok = false;
+        for (int attempt = 0; attempt < 64 && !ok; ++attempt) {
+            int x = 7, y = 7;
+            if (!placed.empty()) {
+                auto [px, py] = placed[rng() % placed.size()];
+                x = px; y = py;
+            }
+            x += offset(rng);
+            y += offset(rng);
+            if (game.placePiece(x, y)) {
+                placed.emplace_back(x, y);
+                ok = true;
+            }
+        }
+        if (!ok) break; // 邻域已满，提前结束
+    }
+    return (int)placed.size();
+}
+
+inline void copyBoard(const GomokuLogic& game, int b[15][15]) {
+    std::memcpy(b, game.getBoard(), sizeof(int) * 15 * 15);
+}
+
+inline void dumpBoard(const int b[15][15]) {
+    for (int i = 0; i < 15; ++i) {
+        for (int j = 0; j < 15; ++j) std::putchar(b[i][j] == 1 ? 'X' : b[i][j] == 2 ? 'O' : '.');
+        std::putchar('\n');
+    }
+}
+
+#endif //MY_APP_TOOLS_BOARDGEN_H
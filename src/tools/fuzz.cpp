@@ -0,0 +1,348 @@
+// 差分模糊测试：在随机真实局面上逐项比较 boardEval 原语与参考实现（tools/reference.h），
+// 并交叉验证 isWin 与 GomokuLogic::checkWinFrom 两套胜负检测、增量威胁表与逐格扫描。
+// 任一检查不一致即打印首个反例局面，最终以非零码退出。
+// 用法: gomoku_fuzz [positions=100000] [seed=1]
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "widget/boardEval.h"
+#include "widget/gomokuLogic.h"
+#include "tools/boardGen.h"
+#include "tools/reference.h"
+
+struct Case {
+    GomokuLogic game;
+    int b[BOARD_SIZE][BOARD_SIZE];
+};
+
+static bool samePatterns(const PatternCount& a, const ref::PatternCount& r) {
+    return a.five == r.five && a.o4 == r.o4 && a.b4 == r.b4 && a.o3 == r.o3 &&
+           a.b3 == r.b3 && a.o2 == r.o2 && a.b2 == r.b2;
+}
+
+static std::string format(const char* fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return buf;
+}
+
+// 每项检查：返回 false 表示不一致，detail 记录反例位置
+using CheckFn = bool (*)(const Case&, std::string& detail);
+
+static bool checkCountPatternsLine(const Case& c, std::string& detail) {
+    const int* ptr = &c.b[0][0];
+    for (int k = 0; k < BOARD_SIZE; ++k) {
+        for (int color = 1; color <= 2; ++color) {
+            // 横向与纵向
+            for (int stride : {1, BOARD_SIZE}) {
+                const int* start = (stride == 1) ? ptr + k * BOARD_SIZE : ptr + k;
+                PatternCount pc; ref::PatternCount rc;
+                countPatternsLine(start, stride, BOARD_SIZE, color, pc);
+                ref::countPatternsLine(start, stride, BOARD_SIZE, color, rc);
+                if (!samePatterns(pc, rc)) {
+                    detail = format("line=%d stride=%d color=%d", k, stride, color);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool checkEvaluate(const Case& c, std::string& detail) {
+    int got = evaluate(c.b), want = ref::evaluate(c.b);
+    if (got == want) return true;
+    detail = format("got=%d want=%d", got, want);
+    return false;
+}
+
+static bool checkGenMoves(const Case& c, std::string& detail) {
+    std::vector<Move> got;
+    std::vector<ref::Move> want;
+    genMoves(c.b, got, 2);
+    ref::genMoves(c.b, want, 2);
+    if (got.size() != want.size()) {
+        detail = format("size got=%zu want=%zu", got.size(), want.size());
+        return false;
+    }
+    for (size_t i = 0; i < got.size(); ++i) {
+        if (got[i].x != want[i].x || got[i].y != want[i].y || got[i].score != want[i].score) {
+            detail = format("index=%zu got=(%d,%d,%d) want=(%d,%d,%d)", i, got[i].x, got[i].y, got[i].score,
+                            want[i].x, want[i].y, want[i].score);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool checkCellPrimitives(const Case& c, std::string& detail) {
+    static constexpr int DIRS[4][2] = {{1,0},{0,1},{1,1},{1,-1}};
+    for (int i = 0; i < BOARD_SIZE; ++i) {
+        for (int j = 0; j < BOARD_SIZE; ++j) {
+            if (isWin(c.b, i, j) != ref::isWin(c.b, i, j)) { detail = format("isWin (%d,%d)", i, j); return false; }
+            if (c.b[i][j] != 0) continue;
+            for (int color = 1; color <= 2; ++color) {
+                if (makesFive(c.b, i, j, color) != ref::makesFive(c.b, i, j, color)) {
+                    detail = format("makesFive (%d,%d) color=%d", i, j, color);
+                    return false;
+                }
+                for (auto& d : DIRS) {
+                    LineInfo li = lineInfoAfter(c.b, i, j, color, d[0], d[1]);
+                    ref::LineInfo rl = ref::lineInfoAfter(c.b, i, j, color, d[0], d[1]);
+                    if (li.count != rl.count || li.openEnds != rl.openEnds) {
+                        detail = format("lineInfoAfter (%d,%d) color=%d", i, j, color);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// 两套独立实现的胜负检测互相印证
+static bool checkWinConsistency(const Case& c, std::string& detail) {
+    for (int i = 0; i < BOARD_SIZE; ++i) {
+        for (int j = 0; j < BOARD_SIZE; ++j) {
+            if (c.b[i][j] != 0 && isWin(c.b, i, j) != c.game.checkWinFrom(i, j)) {
+                detail = format("(%d,%d)", i, j);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 暴力判定用的辅助函数：只依赖 makesFive / isWin，不复用 ThreatMap 的窗口扫描
+// 在 (x,y) 落 color 后，再落一子即可构成经过 (x,y) 的五连的空位个数（这样的空位必在四条线上 4 格以内）
+static int fivePointsThrough(int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int color) {
+    static constexpr int DIRS[4][2] = {{1,0},{0,1},{1,1},{1,-1}};
+    b[x][y] = color;
+    int n = 0;
+    for (auto& d : DIRS) {
+        for (int k = -4; k <= 4; ++k) {
+            int ex = x + k * d[0], ey = y + k * d[1];
+            if (k == 0 || !inBoard2(ex, ey) || b[ex][ey] != 0) continue;
+            b[ex][ey] = color;
+            n += isWin(b, x, y);
+            b[ex][ey] = 0;
+        }
+    }
+    b[x][y] = 0;
+    return n;
+}
+
+static bool hasFivePoint(const int b[BOARD_SIZE][BOARD_SIZE], int color) {
+    for (int i = 0; i < BOARD_SIZE; ++i)
+        for (int j = 0; j < BOARD_SIZE; ++j)
+            if (makesFive(b, i, j, color)) return true;
+    return false;
+}
+
+// 活四点：落子后出现两个以上成五点（调用方保证此前 color 没有成五点）
+static bool hasOpenFourPoint(int b[BOARD_SIZE][BOARD_SIZE], int color) {
+    for (int i = 0; i < BOARD_SIZE; ++i)
+        for (int j = 0; j < BOARD_SIZE; ++j)
+            if (b[i][j] == 0 && fivePointsThrough(b, i, j, color) >= 2) return true;
+    return false;
+}
+
+// 增量威胁表：乱序落子并穿插落子/提子后，应与整盘重建完全一致，且每格与 lineInfoAfter / makesFive 吻合
+static bool checkThreatMapUpdate(const Case& c, std::string& detail) {
+    static constexpr int DIRS[4][2] = {{1,0},{0,1},{1,1},{1,-1}};
+    int b[BOARD_SIZE][BOARD_SIZE] = {};
+    ThreatMap inc, full;
+    inc.rebuild(b);
+    // 97 与 225 互素，k*97 mod 225 遍历所有格子且与行序无关
+    for (int k = 0; k < BOARD_SIZE * BOARD_SIZE; ++k) {
+        int cell = k * 97 % (BOARD_SIZE * BOARD_SIZE), x = cell / BOARD_SIZE, y = cell % BOARD_SIZE;
+        if (c.b[x][y] != 0) {
+            b[x][y] = c.b[x][y];
+            inc.update(b, x, y);
+        } else if (k % 3 == 0) {
+            b[x][y] = 1 + k % 2;
+            inc.update(b, x, y);
+            b[x][y] = 0;
+            inc.update(b, x, y);
+        }
+    }
+    full.rebuild(c.b);
+    if (!(inc == full)) { detail = "incremental != rebuild"; return false; }
+    for (int i = 0; i < BOARD_SIZE; ++i) {
+        for (int j = 0; j < BOARD_SIZE; ++j) {
+            if (c.b[i][j] != 0) continue;
+            for (int color = 1; color <= 2; ++color) {
+                uint8_t f = full.flags(color, i, j);
+                if (((f & ThreatMap::T_FIVE) != 0) != makesFive(c.b, i, j, color)) {
+                    detail = format("T_FIVE (%d,%d) color=%d", i, j, color);
+                    return false;
+                }
+                if (f & ThreatMap::T_FIVE) continue;
+                int points = fivePointsThrough(b, i, j, color);
+                if (((f & ThreatMap::T_FOUR) != 0) != (points >= 1) || ((f & ThreatMap::T_OPEN_FOUR) != 0) != (points >= 2)) {
+                    detail = format("T_FOUR/T_OPEN_FOUR (%d,%d) color=%d points=%d", i, j, color, points);
+                    return false;
+                }
+                for (int d = 0; d < 4; ++d) {
+                    LineInfo li = lineInfoAfter(c.b, i, j, color, DIRS[d][0], DIRS[d][1]);
+                    LineInfo got = full.info(color, i, j, d);
+                    if (li.count != got.count || li.openEnds != got.openEnds) {
+                        detail = format("info (%d,%d) color=%d dir=%d", i, j, color, d);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// 威胁等级：3 本方可成五，2 对方可成五，1 对方有活四点，0 无威胁
+static int threatLevel(int b[BOARD_SIZE][BOARD_SIZE], int player) {
+    const int opp = (player == 1) ? 2 : 1;
+    if (hasFivePoint(b, player)) return 3;
+    if (hasFivePoint(b, opp)) return 2;
+    if (hasOpenFourPoint(b, opp)) return 1;
+    return 0;
+}
+
+// 按定义判断 (x,y) 是否是合格的强制应对：
+// 等级 3 只能成五；等级 2 只能堵五；等级 1 落子后对方不能成五，且对方不再有活四点或本方出现成五点（冲四反击）
+static bool isForcedResponse(int b[BOARD_SIZE][BOARD_SIZE], int player, int level, int x, int y) {
+    const int opp = (player == 1) ? 2 : 1;
+    if (level == 3) return makesFive(b, x, y, player);
+    if (level == 2) return makesFive(b, x, y, opp);
+    b[x][y] = player;
+    bool ok = !hasFivePoint(b, opp) && (hasFivePoint(b, player) || !hasOpenFourPoint(b, opp));
+    b[x][y] = 0;
+    return ok;
+}
+
+// 查表版 genMoves：不裁剪时与参考实现逐项一致；裁剪时只返回强制应对，且不遗漏（截断前）
+static bool checkThreatGenMoves(const Case& c, std::string& detail) {
+    ThreatMap tm;
+    tm.rebuild(c.b);
+    std::vector<Move> got;
+    std::vector<ref::Move> want;
+    genMoves(c.b, tm, 1, got, 2, false);
+    ref::genMoves(c.b, want, 2);
+    if (got.size() != want.size()) {
+        detail = format("unforced size got=%zu want=%zu", got.size(), want.size());
+        return false;
+    }
+    for (size_t i = 0; i < got.size(); ++i) {
+        if (got[i].x != want[i].x || got[i].y != want[i].y || got[i].score != want[i].score) {
+            detail = format("unforced index=%zu got=(%d,%d,%d) want=(%d,%d,%d)", i, got[i].x, got[i].y,
+                            got[i].score, want[i].x, want[i].y, want[i].score);
+            return false;
+        }
+    }
+    int b[BOARD_SIZE][BOARD_SIZE];
+    std::memcpy(b, c.b, sizeof(b));
+    for (int player = 1; player <= 2; ++player) {
+        bool pruned = genMoves(c.b, tm, player, got, 2, true);
+        int level = threatLevel(b, player);
+        if (pruned != (level > 0)) {
+            detail = format("player=%d pruned=%d level=%d", player, (int)pruned, level);
+            return false;
+        }
+        if (!pruned) continue;
+        // 强制应对必紧邻棋子，全部落在候选区域内；逐格核对，截断前不得遗漏
+        size_t expected = 0;
+        for (int i = 0; i < BOARD_SIZE; ++i)
+            for (int j = 0; j < BOARD_SIZE; ++j)
+                if (b[i][j] == 0 && isForcedResponse(b, player, level, i, j)) ++expected;
+        if (got.size() != std::min<size_t>(expected, 40)) {
+            detail = format("player=%d level=%d forced size got=%zu want=%zu", player, level, got.size(), expected);
+            return false;
+        }
+        for (const Move& m : got) {
+            if (!isForcedResponse(b, player, level, m.x, m.y)) {
+                detail = format("player=%d (%d,%d) is not a forced response", player, m.x, m.y);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 查表版 genForcingMoves 与逐格扫描版逐项一致
+static bool checkThreatForcing(const Case& c, std::string& detail) {
+    ThreatMap tm;
+    tm.rebuild(c.b);
+    for (int player = 1; player <= 2; ++player) {
+        std::vector<Move> got, want;
+        bool gotBlock = false, wantBlock = false;
+        bool gotWin = genForcingMoves(tm, player, got, gotBlock, 6);
+        bool wantWin = genForcingMoves(c.b, player, want, wantBlock, 6);
+        if (gotWin != wantWin) { detail = format("player=%d win got=%d", player, (int)gotWin); return false; }
+        if (wantWin) continue;
+        if (gotBlock != wantBlock || got.size() != want.size()) {
+            detail = format("player=%d mustBlock=%d/%d size=%zu/%zu", player, (int)gotBlock, (int)wantBlock,
+                            got.size(), want.size());
+            return false;
+        }
+        for (size_t i = 0; i < got.size(); ++i) {
+            if (got[i].x != want[i].x || got[i].y != want[i].y || got[i].score != want[i].score) {
+                detail = format("player=%d index=%zu", player, i);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct Check {
+    const char* name;
+    CheckFn fn;
+    long long failures = 0;
+};
+
+int main(int argc, char** argv) {
+    long long positions = argc > 1 ? std::atoll(argv[1]) : 100000;
+    unsigned long long seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+
+    Check checks[] = {
+        {"countPatternsLine", checkCountPatternsLine},
+        {"evaluate", checkEvaluate},
+        {"genMoves", checkGenMoves},
+        {"isWin/makesFive/lineInfoAfter", checkCellPrimitives},
+        {"isWin vs checkWinFrom", checkWinConsistency},
+        {"ThreatMap update", checkThreatMapUpdate},
+        {"genMoves(ThreatMap)", checkThreatGenMoves},
+        {"genForcingMoves(ThreatMap)", checkThreatForcing},
+    };
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> stoneDist(1, 120);
+    Case c;
+    for (long long n = 0; n < positions; ++n) {
+        randomGame(rng, stoneDist(rng), c.game);
+        copyBoard(c.game, c.b);
+        for (auto& chk : checks) {
+            std::string detail;
+            if (chk.fn(c, detail)) continue;
+            if (chk.failures++ == 0) {
+                std::printf("MISMATCH %s at position %lld: %s\n", chk.name, n, detail.c_str());
+                dumpBoard(c.b);
+            }
+        }
+    }
+
+    long long total = 0;
+    for (auto& chk : checks) {
+        std::printf("%-32s %s (%lld failures)\n", chk.name, chk.failures ? "FAIL" : "ok", chk.failures);
+        total += chk.failures;
+    }
+    std::printf("positions=%lld seed=%llu\n", positions, seed);
+    return total ? 1 : 0;
+}
@@ -0,0 +1,461 @@
+// 棋谱导入与局面索引构建：流式读取大规模棋谱库，多线程重放并去重，输出带胜/和/负（及结果未知）统计的有序局面索引。
+//
+// 输入格式（按行自动识别，可混用）：
+//   1) 纯着法列表：每行一局，空白分隔的 "x,y"，可选以 BLACK / WHITE / DRAW 结尾声明结果；'#' 开头为注释。
+//   2) gomoku_core 对局记录（对战脚本保存的 stdout）：GAME_STARTED 开局，MOVED x,y,c 为着法，WINNER ... 结束。
+//
+// 流水线：读取线程解析棋谱 -> 有界队列 -> 工作线程用 GomokuLogic 重放，
+// 每一步后的局面取 8 种对称变换下最小的 Zobrist 键作为规范键 -> 线程内缓冲达到上限时排序合并写出有序分段，
+// 最后多路归并所有分段得到索引文件。内存占用只与线程数和分段大小有关，与棋谱库规模无关。
+//
+// 用法: gomoku_ingest -o index.bin [--threads N] [--run-records N] [--tmp DIR] input... ("-" 表示标准输入)
+// 分段文件写在 --tmp（默认系统临时目录）下本进程独有的子目录中，退出时连同子目录一并删除。
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "widget/boardEval.h"
+#include "widget/gomokuLogic.h"
+
+namespace fs = std::filesystem;
+
+// 索引记录：胜负统计恒以黑方视角记录
+struct IndexRecord {
+    uint64_t key;
+    uint32_t blackWins;
+    uint32_t draws;
+    uint32_t whiteWins;
+    uint32_t unknown;   // 未下完且未声明结果的对局，不计入胜/和/负
+};
+static_assert(sizeof(IndexRecord) == 24, "IndexRecord must stay 24 bytes on disk");
+
+struct IndexHeader {
+    char magic[8];          // "GMKINDEX"
+    uint32_t version;
+    uint32_t recordSize;    // sizeof(IndexRecord)
+    uint64_t zobristCheck;  // zobristFingerprint()
+    uint64_t count;
+};
+static_assert(sizeof(IndexHeader) == 32, "IndexHeader must stay 32 bytes on disk");
+
+static constexpr char INDEX_MAGIC[8] = {'G','M','K','I','N','D','E','X'};
+static constexpr uint32_t INDEX_VERSION = 2; // v2：reserved 字段改为 unknown 计数
+static constexpr size_t BATCH_GAMES = 256;   // 每个队列元素的对局数
+static constexpr size_t QUEUE_BATCHES = 64;  // 队列上限（批）
+static constexpr size_t MAX_FAN_IN = 128;    // 单次归并最多打开的分段数
+
+enum GameResult { ResultUnknown, ResultBlack, ResultWhite, ResultDraw };
+
+struct GameRecord {
+    std::vector<std::pair<int, int>> moves;
+    GameResult declared = ResultUnknown;
+};
+
+// ---------- 解析 ----------
+
+static GameResult parseResult(const std::string& tok) {
+    if (tok == "BLACK") return ResultBlack;
+    if (tok == "WHITE") return ResultWhite;
+    if (tok == "DRAW") return ResultDraw;
+    return ResultUnknown;
+}
+
+static bool parseCoord(const std::string& tok, int& x, int& y) {
+    return std::sscanf(tok.c_str(), "%d,%d", &x, &y) == 2;
+}
+
+// 逐行读取并切分出对局；两种格式共用一个状态机
+class GameReader {
+public:
+    explicit GameReader(std::istream& in) : in_(in) {}
+
+    bool next(GameRecord& g, long long& badLines) {
+        std::string line;
+        while (std::getline(in_, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream ss(line);
+            std::string head;
+            ss >> head;
+            if (head == "GAME_STARTED") {
+                bool hadGame = inTranscript_ && !cur_.moves.empty();
+                GameRecord finished = std::move(cur_);
+                cur_ = GameRecord{};
+                inTranscript_ = true;
+                if (hadGame) { g = std::move(finished); return true; }
+                continue;
+            }
+            if (head == "MOVED" && inTranscript_) {
+                std::string coord;
+                int x, y;
+                if (ss >> coord && parseCoord(coord, x, y)) cur_.moves.emplace_back(x, y);
+                else ++badLines;
+                continue;
+            }
+            if (head == "WINNER" && inTranscript_) {
+                std::string who;
+                ss >> who;
+                cur_.declared = parseResult(who);
+                inTranscript_ = false;
+                g = std::move(cur_);
+                cur_ = GameRecord{};
+                if (!g.moves.empty()) return true;
+                continue;
+            }
+            if (inTranscript_) continue; // 对局记录中的其他输出（AI_THINKING、STATS 等）
+
+            // 纯着法列表
+            GameRecord plain;
+            std::string tok = head;
+            bool ok = true;
+            do {
+                int x, y;
+                if (parseCoord(tok, x, y)) plain.moves.emplace_back(x, y);
+                else if (parseResult(tok) != ResultUnknown) plain.declared = parseResult(tok);
+                else { ok = false; break; }
+            } while (ss >> tok);
+            if (!ok || plain.moves.empty()) { ++badLines; continue; }
+            g = std::move(plain);
+            return true;
+        }
+        // 文件结束：未收尾的对局记录也交出去
+        if (inTranscript_ && !cur_.moves.empty()) {
+            inTranscript_ = false;
+            g = std::move(cur_);
+            cur_ = GameRecord{};
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::istream& in_;
+    GameRecord cur_;
+    bool inTranscript_ = false;
+};
+
+// ---------- 有界队列 ----------
+
+class BatchQueue {
+public:
+    void push(std::vector<GameRecord>&& batch) {
+        std::unique_lock<std::mutex> lock(m_);
+        notFull_.wait(lock, [&] { return q_.size() < QUEUE_BATCHES; });
+        q_.push_back(std::move(batch));
+        notEmpty_.notify_one();
+    }
+    bool pop(std::vector<GameRecord>& batch) {
+        std::unique_lock<std::mutex> lock(m_);
+        notEmpty_.wait(lock, [&] { return !q_.empty() || closed_; });
+        if (q_.empty()) return false;
+        batch = std::move(q_.front());
+        q_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+    void close() {
+        std::lock_guard<std::mutex> lock(m_);
+        closed_ = true;
+        notEmpty_.notify_all();
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable notEmpty_, notFull_;
+    std::deque<std::vector<GameRecord>> q_;
+    bool closed_ = false;
+};
+
+// ---------- 规范化 ----------
+
+// 8 种对称变换（旋转 / 镜像）
+static void transformCoord(int t, int x, int y, int& tx, int& ty) {
+    const int n = BOARD_SIZE - 1;
+    switch (t) {
+        case 0: tx = x;     ty = y;     break;
+        case 1: tx = y;     ty = n - x; break;
+        case 2: tx = n - x; ty = n - y; break;
+        case 3: tx = n - y; ty = x;     break;
+        case 4: tx = x;     ty = n - y; break;
+        case 5: tx = n - x; ty = y;     break;
+        case 6: tx = y;     ty = x;     break;
+        default: tx = n - y; ty = n - x; break;
+    }
+}
+
+// ---------- 分段写出与归并 ----------
+
+// 按 key 排序并合并同键统计（原地）
+static void sortAndCombine(std::vector<IndexRecord>& recs) {
+    std::sort(recs.begin(), recs.end(), [](const IndexRecord& a, const IndexRecord& b) { return a.key < b.key; });
+    size_t out = 0;
+    for (size_t i = 0; i < recs.size(); ++i) {
+        if (out > 0 && recs[out - 1].key == recs[i].key) {
+            recs[out - 1].blackWins += recs[i].blackWins;
+            recs[out - 1].draws += recs[i].draws;
+            recs[out - 1].whiteWins += recs[i].whiteWins;
+            recs[out - 1].unknown += recs[i].unknown;
+        } else {
+            recs[out++] = recs[i];
+        }
+    }
+    recs.resize(out);
+}
+
+static bool writeRecords(const fs::path& path, const std::vector<IndexRecord>& recs) {
+    FILE* f = std::fopen(path.string().c_str(), "wb");
+    if (!f) return false;
+    bool ok = recs.empty() || std::fwrite(recs.data(), sizeof(IndexRecord), recs.size(), f) == recs.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+// 多路归并若干有序分段；header 非空时写出索引文件头。返回写出的记录数，失败返回 -1
+static long long mergeRuns(const std::vector<fs::path>& runs, const fs::path& out, bool header) {
+    std::vector<FILE*> files;
+    for (const auto& r : runs) {
+        FILE* f = std::fopen(r.string().c_str(), "rb");
+        if (!f) { for (FILE* o : files) std::fclose(o); return -1; }
+        files.push_back(f);
+    }
+    FILE* dst = std::fopen(out.string().c_str(), "wb");
+    if (!dst) { for (FILE* f : files) std::fclose(f); return -1; }
+
+    IndexHeader hdr{};
+    if (header) {
+        std::memcpy(hdr.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        hdr.version = INDEX_VERSION;
+        hdr.recordSize = sizeof(IndexRecord);
+        hdr.zobristCheck = zobristFingerprint();
+        std::fwrite(&hdr, sizeof(hdr), 1, dst); // count 最后回填
+    }
+
+    using Head = std::pair<uint64_t, size_t>; // (key, 分段下标)
+    std::priority_queue<Head, std::vector<Head>, std::greater<>> heap;
+    std::vector<IndexRecord> cur(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (std::fread(&cur[i], sizeof(IndexRecord), 1, files[i]) == 1) heap.emplace(cur[i].key, i);
+    }
+
+    long long written = 0;
+    bool ok = true;
+    bool havePending = false;
+    IndexRecord pending{};
+    while (!heap.empty()) {
+        auto [key, i] = heap.top();
+        heap.pop();
+        if (havePending && pending.key == key) {
+            pending.blackWins += cur[i].blackWins;
+            pending.draws += cur[i].draws;
+            pending.whiteWins += cur[i].whiteWins;
+            pending.unknown += cur[i].unknown;
+        } else {
+            if (havePending) { ok = ok && std::fwrite(&pending, sizeof(pending), 1, dst) == 1; ++written; }
+            pending = cur[i];
+            havePending = true;
+        }
+        if (std::fread(&cur[i], sizeof(IndexRecord), 1, files[i]) == 1) heap.emplace(cur[i].key, i);
+    }
+    if (havePending) { ok = ok && std::fwrite(&pending, sizeof(pending), 1, dst) == 1; ++written; }
+
+    if (header && ok) {
+        hdr.count = (uint64_t)written;
+        ok = std::fseek(dst, 0, SEEK_SET) == 0 && std::fwrite(&hdr, sizeof(hdr), 1, dst) == 1;
+    }
+    for (FILE* f : files) std::fclose(f);
+    ok = (std::fclose(dst) == 0) && ok;
+    return ok ? written : -1;
+}
+
+// ---------- 工作线程 ----------
+
+struct WorkerState {
+    std::vector<IndexRecord> buffer;
+    std::vector<fs::path> runs;
+    long long games = 0, positions = 0, illegal = 0, unknown = 0;
+    bool ioError = false;
+};
+
+static void workerLoop(int id, BatchQueue& queue, size_t runRecords, const fs::path& tmpDir, WorkerState& st) {
+    st.buffer.reserve(runRecords);
+    auto spill = [&] {
+        if (st.buffer.empty()) return;
+        sortAndCombine(st.buffer);
+        fs::path run = tmpDir / ("gomoku_run_" + std::to_string(id) + "_" + std::to_string(st.runs.size()) + ".bin");
+        if (!writeRecords(run, st.buffer)) st.ioError = true;
+        st.runs.push_back(run);
+        st.buffer.clear();
+    };
+
+    std::vector<GameRecord> batch;
+    std::vector<uint64_t> keys;
+    GomokuLogic game;
+    while (queue.pop(batch)) {
+        for (const GameRecord& g : batch) {
+            // 重放并记录每一步后的规范键
+            game.reset();
+            keys.clear();
+            uint64_t sym[8] = {};
+            bool legal = true;
+            for (auto [x, y] : g.moves) {
+                int color = (int)game.currentPlayer();
+                if (!game.placePiece(x, y)) { legal = false; break; }
+                uint64_t canon = UINT64_MAX;
+                for (int t = 0; t < 8; ++t) {
+                    int tx, ty;
+                    transformCoord(t, x, y, tx, ty);
+                    sym[t] ^= ZOBRIST[tx][ty][color];
+                    canon = std::min(canon, sym[t]);
+                }
+                keys.push_back(canon);
+            }
+            if (!legal) { ++st.illegal; continue; }
+
+            // 以重放结果为准（含下满棋盘的和棋）；未分胜负时采用棋谱声明的结果，
+            // 两者都没有（未下完、记录被截断）则单独计为 unknown，不冒充和棋
+            GameResult result = g.declared;
+            if (game.state() == GomokuLogic::BlackWin) result = ResultBlack;
+            else if (game.state() == GomokuLogic::WhiteWin) result = ResultWhite;
+            else if (game.state() == GomokuLogic::Draw) result = ResultDraw;
+
+            for (uint64_t k : keys) {
+                st.buffer.push_back({k, result == ResultBlack ? 1u : 0u, result == ResultDraw ? 1u : 0u,
+                                     result == ResultWhite ? 1u : 0u, result == ResultUnknown ? 1u : 0u});
+                if (st.buffer.size() >= runRecords) spill();
+            }
+            if (result == ResultUnknown) ++st.unknown;
+            ++st.games;
+            st.positions += (long long)keys.size();
+        }
+    }
+    spill();
+}
+
+// ---------- main ----------
+
+// 本进程专用的临时目录：建在 --tmp 之下、名字随机，避免多个导入任务互相覆盖分段文件；
+// 析构时整体删除，任何退出路径都不会遗留分段
+struct ScratchDir {
+    fs::path path;
+
+    bool create(const fs::path& parent) {
+        std::random_device rd;
+        std::mt19937_64 rng(((uint64_t)rd() << 32) ^ rd() ^
+                            (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            char name[40];
+            std::snprintf(name, sizeof(name), "gomoku_ingest_%016llx", (unsigned long long)rng());
+            std::error_code ec;
+            if (fs::create_directory(parent / name, ec)) { path = parent / name; return true; }
+            if (ec) return false;
+        }
+        return false;
+    }
+    ~ScratchDir() {
+        if (path.empty()) return;
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+static void usage() {
+    std::fprintf(stderr, "usage: gomoku_ingest -o index.bin [--threads N] [--run-records N] [--tmp DIR] input... (\"-\" = stdin)\n");
+}
+
+int main(int argc, char** argv) {
+    std::string outPath;
+    std::vector<std::string> inputs;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t runRecords = 1 << 20; // 每线程缓冲 24 MB
+    fs::path tmpDir = fs::temp_directory_path();
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-o" && i + 1 < argc) outPath = argv[++i];
+        else if (a == "--threads" && i + 1 < argc) threads = (unsigned)std::max(1, std::atoi(argv[++i]));
+        else if (a == "--run-records" && i + 1 < argc) runRecords = (size_t)std::max(1LL, std::atoll(argv[++i]));
+        else if (a == "--tmp" && i + 1 < argc) tmpDir = argv[++i];
+        else inputs.push_back(a);
+    }
+    if (outPath.empty() || inputs.empty()) { usage(); return 2; }
+    initZobrist();
+
+    ScratchDir scratch;
+    if (!scratch.create(tmpDir)) { std::fprintf(stderr, "cannot create a scratch directory in %s\n", tmpDir.string().c_str()); return 1; }
+
+    BatchQueue queue;
+    std::vector<WorkerState> states(threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(workerLoop, (int)t, std::ref(queue), runRecords, std::cref(scratch.path), std::ref(states[t]));
+    }
+
+    // 读取线程（即主线程）：逐文件流式解析，按批入队
+    long long badLines = 0;
+    bool inputError = false;
+    std::vector<GameRecord> batch;
+    for (const std::string& path : inputs) {
+        std::ifstream file;
+        std::istream* in = &std::cin;
+        if (path != "-") {
+            file.open(path);
+            if (!file) { std::fprintf(stderr, "cannot open %s\n", path.c_str()); inputError = true; continue; }
+            in = &file;
+        }
+        GameReader reader(*in);
+        GameRecord g;
+        while (reader.next(g, badLines)) {
+            batch.push_back(std::move(g));
+            if (batch.size() >= BATCH_GAMES) { queue.push(std::move(batch)); batch.clear(); }
+        }
+    }
+    if (!batch.empty()) queue.push(std::move(batch));
+    queue.close();
+    for (auto& w : workers) w.join();
+
+    long long games = 0, positions = 0, illegal = 0, unknown = 0;
+    std::vector<fs::path> runs;
+    for (auto& st : states) {
+        games += st.games; positions += st.positions; illegal += st.illegal; unknown += st.unknown;
+        if (st.ioError) { std::fprintf(stderr, "failed to write run files in %s\n", scratch.path.string().c_str()); return 1; }
+        runs.insert(runs.end(), st.runs.begin(), st.runs.end());
+    }
+
+    // 分段过多时先分组归并，控制同时打开的文件数
+    int pass = 0;
+    while (runs.size() > MAX_FAN_IN) {
+        std::vector<fs::path> next;
+        for (size_t i = 0; i < runs.size(); i += MAX_FAN_IN) {
+            std::vector<fs::path> group(runs.begin() + (std::ptrdiff_t)i,
+                                        runs.begin() + (std::ptrdiff_t)std::min(runs.size(), i + MAX_FAN_IN));
+            fs::path merged = scratch.path / ("gomoku_merge_" + std::to_string(pass) + "_" + std::to_string(next.size()) + ".bin");
+            if (mergeRuns(group, merged, false) < 0) { std::fprintf(stderr, "merge failed\n"); return 1; }
+            for (const auto& r : group) { std::error_code ec; fs::remove(r, ec); }
+            next.push_back(merged);
+        }
+        runs = std::move(next);
+        ++pass;
+    }
+    long long unique = mergeRuns(runs, outPath, true);
+    for (const auto& r : runs) { std::error_code ec; fs::remove(r, ec); }
+    if (unique < 0) { std::fprintf(stderr, "failed to write %s\n", outPath.c_str()); return 1; }
+
+    std::printf("games=%lld positions=%lld unique=%lld illegal_games=%lld unknown_results=%lld bad_lines=%lld threads=%u\n",
+                games, positions, unique, illegal, unknown, badLines, threads);
+    return inputError ? 1 : 0;
+}
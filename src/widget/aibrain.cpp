@@ -1,4 +1,7 @@
 #include "aibrain.h"
+#include "boardEval.h"
+#include "profile.h"
+#include "searchCache.h"
 #include <vector>
 #include <algorithm>
 #include <chrono>
@@ -20,40 +23,14 @@ AlphaBeta::AlphaBeta(int timeLimitMs,
       useNeighborhood_(useNeighborhood),
       neighborhoodRadius_(neighborhoodRadius) {}
 
-static constexpr int BOARD_SIZE = 15;
-// 模式权重
-static constexpr int SCORE_FIVE = 1'000'000'0;      // 五连
-static constexpr int SCORE_OPEN_FOUR = 1'000'000;    // 活四
-static constexpr int SCORE_BLOCKED_FOUR = 300'000;   // 冲四
-static constexpr int SCORE_OPEN_THREE = 15'000;      // 活三
-static constexpr int SCORE_BLOCKED_THREE = 2'000;    // 眠三
-static constexpr int SCORE_OPEN_TWO = 500;           // 活二
-static constexpr int SCORE_BLOCKED_TWO = 100;        // 眠二
-
-
-// Zobrist 哈希表
-static uint64_t ZOBRIST[BOARD_SIZE][BOARD_SIZE][3]; // 0 unused, 1 black, 2 white
-static bool ZOB_INIT = false;
-
-static void initZobrist(){
-    if(ZOB_INIT) return;
-    std::mt19937_64 rng(0xC0FFEE123456789ULL); // 固定种子保证复现
-    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
-        for(int c=0;c<3;++c){ ZOBRIST[i][j][c] = rng(); }
-    }
-    ZOB_INIT = true;
-}
-
-struct TTEntry { uint64_t hash; int value; int depth; };
+// 置换表条目：value 的含义由 flag 决定（精确值 / 下界 / 上界），bestMove 为 x*15+y（-1 表示无）
+enum TTFlag : int8_t { TT_EXACT, TT_LOWER, TT_UPPER };
+struct TTEntry { uint64_t hash; int value; int8_t depth; TTFlag flag; int16_t bestMove; };
+static_assert(sizeof(TTEntry) == 16);
 static constexpr int TT_SIZE = 0x100000; // 1MB entries
 static constexpr int TT_MASK = TT_SIZE - 1;
 static TTEntry TRANS_TABLE[TT_SIZE];
 
-// 走法结构（含排序用分数）
-struct Move { int x, y; int score; };
-
-static bool inBoard2(int x,int y){ return x>=0 && x<BOARD_SIZE && y>=0 && y<BOARD_SIZE; }
-
 // 当前轮到谁走：黑先规则
 static int inferTurn(const int b[BOARD_SIZE][BOARD_SIZE]){
     int c1=0,c2=0;
@@ -63,276 +40,110 @@ static int inferTurn(const int b[BOARD_SIZE][BOARD_SIZE]){
     return (c1==c2)?1:2;
 }
 
-static uint64_t computeHash(const int b[BOARD_SIZE][BOARD_SIZE]){
-    uint64_t h=0;
-    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
-        int v=b[i][j]; if(v) h ^= ZOBRIST[i][j][v];
+// 单次搜索的上下文：截止时间 / 节点预算、选择性搜索开关、持久化缓存、威胁表与统计
+struct SearchContext {
+    std::chrono::steady_clock::time_point deadline;
+    bool useClock;        // 确定性模式下不看墙钟
+    long long nodeLimit;  // 0 表示不限
+    SearchOptions options;
+    SearchCache* cache;
+    SearchStats stats;
+    ThreatMap threats;    // 随落子 / 提子增量维护，与搜索中的棋盘保持一致
+    bool stopped = false; // 已超时 / 节点用尽：此后的返回值不可信，不写入 TT / 缓存
+
+    bool shouldStop(){
+        if(stopped) return true;
+        // 节点预算只在第 1 层迭代完成后生效，保证至少有一个经过搜索的着法
+        if(nodeLimit>0 && stats.depth>=1 && stats.nodes + stats.qnodes >= nodeLimit) stopped=true;
+        else if(useClock && std::chrono::steady_clock::now() > deadline) stopped=true;
+        return stopped;
     }
-    return h;
-}
-
-// 检测胜利：从 (x,y) 出发四个方向统计连续同色
-static bool isWin(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y){
-    if(!inBoard2(x,y) || b[x][y]==0) return false;
-    int color=b[x][y];
-    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
-    for(auto &d:DIRS){
-        int cnt=1;
-        int dx=d[0], dy=d[1];
-        int nx=x+dx, ny=y+dy;
-        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
-        nx=x-dx; ny=y-dy;
-        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
-        if(cnt>=5) return true;
+};
+
+// 持久化缓存参数
+static constexpr int CACHE_MIN_DEPTH = 3;              // 仅缓存剩余深度不低于此值的精确结果
+static constexpr size_t CACHE_FLUSH_PENDING = 4096;    // 待写条目达到该数量时在两次搜索之间落盘
+
+// 把 TT / 缓存给出的最佳着法提到最前面
+static void promoteMove(std::vector<Move>& moves, int bestMove){
+    if(bestMove<0) return;
+    int bx=bestMove/BOARD_SIZE, by=bestMove%BOARD_SIZE;
+    for(size_t i=1;i<moves.size();++i){
+        if(moves[i].x==bx && moves[i].y==by){ std::rotate(moves.begin(), moves.begin()+i, moves.begin()+i+1); return; }
     }
-    return false;
 }
 
-static bool isDraw(const int b[BOARD_SIZE][BOARD_SIZE]){
-    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j) if(b[i][j]==0) return false;
-    return true;
-}
-
-// 行扫描帮助：统计一行模式出现次数
-struct PatternCount { int five=0, o4=0, b4=0, o3=0, b3=0, o2=0, b2=0; };
-
-// 在一条线（指针+步长）中统计给定颜色的各种模式
-static void countPatternsLine(const int* start, int stride, int length, int color, PatternCount &pc){
-    // 五连、四连、三连、二连模式识别涉及到空位边界
-    for(int i=0;i<length;++i){
-        // Helper lambda for strided access
-        auto at = [&](int idx) { return *(start + idx * stride); };
-        // 跳过空减少一些冗余
-        // 直接五连
-        if(i+4<length){
-            bool five=true; for(int k=0;k<5;++k) if(at(i+k)!=color){ five=false; break; }
-            if(five){ pc.five++; continue; }
-        }
-        // 检查 6 长度窗口用于开放端判断
-        if(i+5<length){
-            // 活四: 0 C C C C 0 (中间四个, 两端空)
-            if(at(i)==0 && at(i+5)==0){
-                int cnt=0; for(int k=1;k<=4;++k) if(at(i+k)==color) ++cnt; else break; if(cnt==4) pc.o4++; // 0CCCC0
-            }
-            // 冲四（阻塞四）: 0 C C C C X 或 X C C C C 0 （一端空一端非空）
-            // 或 C C C C 0 X / X 0 C C C C 等扩展——简化：窗口中含恰好四个连续 color + 至少一端空另一端非空
-            int cCnt=0; for(int k=0;k<6;++k) if(at(i+k)==color) cCnt++;
-            if(cCnt==4){
-                // 统计端点情况
-                bool leftEmpty = at(i)==0; bool rightEmpty = at(i+5)==0;
-                bool leftBlocked = (!leftEmpty && at(i)!=color);
-                bool rightBlocked = (!rightEmpty && at(i+5)!=color);
-                if((leftEmpty && rightBlocked) || (rightEmpty && leftBlocked)) pc.b4++; // 一端空一端被阻
-            }
-        }
+// 选择性搜索参数
+// 威胁着法（成五/堵五/冲四/活三及其防守）永不减深或剪枝。genMoves 打分只看连续子，
+// 因此除打分阈值外还要查威胁表的窗口棋型，跳四、跳三及其堵点同样算威胁
+static constexpr int THREAT_SCORE = SCORE_OPEN_THREE/2;
+static constexpr uint8_t THREAT_FLAGS = ThreatMap::T_FIVE | ThreatMap::T_FOUR | ThreatMap::T_OPEN_THREE;
 
-        if(i+5<length){
-            // 6 长度
-            // 活三模式简化：0 C C C 0 0, 0 0 C C C 0, 0 C C 0 C 0 等更复杂；这里采取枚举出现 "0 C C C 0" 子串并保证两侧至少一个额外空
-            // 用更保守实现：匹配子串 0 C C C 0 且周围再有一个空位 -> 活三，否则眠三
-            bool pattern=true; if(at(i)==0 && at(i+4)==0){ for(int k=1;k<=3;++k) if(at(i+k)!=color){ pattern=false; break; } }
-            else pattern=false;
-            if(pattern){
-                bool extraLeft = (i-1>=0 && at(i-1)==0);
-                bool extraRight = (i+5<length && at(i+5)==0);
-                if(extraLeft || extraRight) pc.o3++; else pc.b3++;
-            }
-        }
-        if(i+4<length){
-            // 5 长度窗口用于眠三/活二等简化识别
-            // 眠三候选： C C C 0 X / X 0 C C C / 0 C C C X / X C C C 0 等——简化：窗口内有3个 color, 其余有一个空，一个阻塞
-            int cCnt=0, emptyCnt=0; for(int k=0;k<5;++k){ int v=at(i+k); if(v==color) cCnt++; else if(v==0) emptyCnt++; }
-            if(cCnt==3 && emptyCnt==2){
-                // 如果两个空分布在两端则更像活三，已经上面识别；否则归为眠三
-                bool endsEmpty = (at(i)==0 && at(i+4)==0);
-                if(!endsEmpty) pc.b3++;
-            }
-            // 活二：0 C C 0 0 或 0 0 C C 0 或 0 C 0 C 0
-            if(cCnt==2 && emptyCnt>=3){
-                bool endsEmpty = (at(i)==0 && at(i+4)==0);
-                if(endsEmpty) pc.o2++; else pc.b2++;
-            }
-        }
-    }
+static bool isThreatMove(const Move& m, int player, const ThreatMap& tm){
+    const int opp = (player==1)?2:1;
+    return m.score >= THREAT_SCORE || ((tm.flags(player,m.x,m.y) | tm.flags(opp,m.x,m.y)) & THREAT_FLAGS);
 }
-
-static int evaluate(const int b[BOARD_SIZE][BOARD_SIZE]){
-    // 终局快速检测（高权重）
-    // 若存在直接五连返回极值避免继续
-    // 全面扫描
-    PatternCount blackCount, whiteCount;
-
-    // Get raw pointer for strided access
-    const int* ptr = &b[0][0];
-
-    // 横向
-    for(int i=0;i<BOARD_SIZE;++i){
-        countPatternsLine(ptr + i*BOARD_SIZE, 1, BOARD_SIZE, 1, blackCount);
-        countPatternsLine(ptr + i*BOARD_SIZE, 1, BOARD_SIZE, 2, whiteCount);
+static constexpr int LMR_MIN_DEPTH = 3;     // 剩余深度不足时不减深
+static constexpr size_t LMR_FULL_MOVES = 4; // 前若干个着法始终全深度搜索
+static constexpr int FUTILITY_DEPTH = 2;    // 仅在叶子附近做无益剪枝
+static constexpr int FUTILITY_MARGIN[FUTILITY_DEPTH+1] = {0, SCORE_OPEN_THREE, SCORE_OPEN_THREE*3};
+
+// 静态搜索参数：只沿强制着法延伸，深度与分支都需严格限制
+static constexpr int QS_MAX_DEPTH = 4;
+static constexpr size_t QS_MAX_BRANCH = 6;
+
+// 静态搜索（quiescence）：在主搜索地平线处继续展开强制着法，避免冲四/活三悬而未决时直接估值
+static int quiescence(int b[BOARD_SIZE][BOARD_SIZE], int alpha, int beta, int player,
+                      int lastX, int lastY, int qdepth, SearchContext& ctx){
+    GOMOKU_PROFILE_SCOPE(PF_QUIESCENCE);
+    ++ctx.stats.qnodes;
+    if(inBoard2(lastX,lastY) && isWin(b,lastX,lastY)){
+        return (b[lastX][lastY]==1)? SCORE_FIVE : -SCORE_FIVE;
     }
-    // 纵向
-    for(int j=0;j<BOARD_SIZE;++j){
-        countPatternsLine(ptr + j, BOARD_SIZE, BOARD_SIZE, 1, blackCount);
-        countPatternsLine(ptr + j, BOARD_SIZE, BOARD_SIZE, 2, whiteCount);
+    std::vector<Move> moves;
+    bool mustBlock=false;
+    if(genForcingMoves(ctx.threats, player, moves, mustBlock, QS_MAX_BRANCH)){
+        return (player==1)? SCORE_FIVE : -SCORE_FIVE; // 本方一步成五
     }
-    // 主对角线族
-    // k=0: (0,0) -> (14,14)
-    countPatternsLine(ptr, BOARD_SIZE+1, BOARD_SIZE, 1, blackCount);
-    countPatternsLine(ptr, BOARD_SIZE+1, BOARD_SIZE, 2, whiteCount);
 
-    for(int k=1;k<BOARD_SIZE;++k){
-        // 上三角: (0,k) -> (14-k, 14)
-        int len = BOARD_SIZE - k;
-        if(len>=5){
-             countPatternsLine(ptr + k, BOARD_SIZE+1, len, 1, blackCount);
-             countPatternsLine(ptr + k, BOARD_SIZE+1, len, 2, whiteCount);
+    int standPat = evaluate(b);
+    // 对方已有成五点时不能"停着"，必须应对
+    if(!mustBlock){
+        if(player==1){
+            if(standPat>=beta) return standPat;
+            alpha = std::max(alpha, standPat);
+        } else {
+            if(standPat<=alpha) return standPat;
+            beta = std::min(beta, standPat);
         }
-        // 下三角: (k,0) -> (14, 14-k)
-        if(len>=5){
-             countPatternsLine(ptr + k*BOARD_SIZE, BOARD_SIZE+1, len, 1, blackCount);
-             countPatternsLine(ptr + k*BOARD_SIZE, BOARD_SIZE+1, len, 2, whiteCount);
-        }
-    }
-    // 副对角线族
-    for(int k=0;k<BOARD_SIZE;++k){
-        int len = k+1;
-        if(len>=5){
-            countPatternsLine(ptr + k, BOARD_SIZE-1, len, 1, blackCount);
-            countPatternsLine(ptr + k, BOARD_SIZE-1, len, 2, whiteCount);
-        }
-    }
-    for(int k=1;k<BOARD_SIZE;++k){
-        int len = BOARD_SIZE - k;
-        if(len>=5){
-            countPatternsLine(ptr + k*BOARD_SIZE + (BOARD_SIZE-1), BOARD_SIZE-1, len, 1, blackCount);
-            countPatternsLine(ptr + k*BOARD_SIZE + (BOARD_SIZE-1), BOARD_SIZE-1, len, 2, whiteCount);
-        }
-    }
-
-    // 即胜直接返回
-    if(blackCount.five>0) return SCORE_FIVE; // 极大正分
-    if(whiteCount.five>0) return -SCORE_FIVE;
-
-    auto scoreSide=[&](const PatternCount &pc){
-        long long s=0;
-        s += (long long)pc.five * SCORE_FIVE;
-        s += (long long)pc.o4 * SCORE_OPEN_FOUR;
-        s += (long long)pc.b4 * SCORE_BLOCKED_FOUR;
-        s += (long long)pc.o3 * SCORE_OPEN_THREE;
-        s += (long long)pc.b3 * SCORE_BLOCKED_THREE;
-        s += (long long)pc.o2 * SCORE_OPEN_TWO;
-        s += (long long)pc.b2 * SCORE_BLOCKED_TWO;
-        // 单子：约略统计棋盘上该颜色子数用于微调
-        // 这里不再额外扫描，简单按模式权重即可
-        return (int)s;
-    };
-    int blackScore = scoreSide(blackCount);
-    int whiteScore = scoreSide(whiteCount);
-    return blackScore - whiteScore; // 黑优为正
-}
-
-// 局部快速打分：为走法排序（不需要全面模式统计）
-static int quickHeuristic(const int b[BOARD_SIZE][BOARD_SIZE], int x,int y, int color){
-    // 检查四个方向最大连续潜力 (包含当前落子) 作为粗启发
-    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
-    int total=0;
-    for(auto &d:DIRS){
-        int dx=d[0],dy=d[1];
-        int cnt=1; // 包含自己
-        int nx=x+dx, ny=y+dy;
-        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
-        nx=x-dx; ny=y-dy;
-        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
-        total += cnt*cnt; // 二次加权
-    }
-    return total;
-}
-
-// 在不落子的情况下判断：若把 'color' 落在 (x,y) 是否形成五连
-static bool makesFive(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int color){
-    if(!inBoard2(x,y) || b[x][y]!=0) return false;
-    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
-    for(auto &d:DIRS){
-        int dx=d[0], dy=d[1];
-        int cnt=1; // 计入当前假设落子
-        int nx=x+dx, ny=y+dy;
-        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
-        nx=x-dx; ny=y-dy;
-        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
-        if(cnt>=5) return true;
-    }
-    return false;
-}
-
-struct LineInfo { int count; int openEnds; };
-static LineInfo lineInfoAfter(const int b[BOARD_SIZE][BOARD_SIZE], int x,int y,int color,int dx,int dy){
-    // 统计以 (x,y) 假设为 color 时，在方向(dx,dy)的连续数量及开放端数
-    int cnt=1; int open=0;
-    int nx=x+dx, ny=y+dy;
-    while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
-    if(inBoard2(nx,ny) && b[nx][ny]==0) ++open;
-    nx=x-dx; ny=y-dy;
-    while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
-    if(inBoard2(nx,ny) && b[nx][ny]==0) ++open;
-    return {cnt, open};
-}
-
-static void genMoves(const int b[BOARD_SIZE][BOARD_SIZE], std::vector<Move>& out, int radius){
-    out.clear();
-    bool any=false;
-    for(int i=0;i<BOARD_SIZE && !any;++i) for(int j=0;j<BOARD_SIZE;++j) if(b[i][j]!=0){ any=true; break; }
-    if(!any){ out.push_back({BOARD_SIZE/2, BOARD_SIZE/2, 0}); return; }
-    int minX=BOARD_SIZE, minY=BOARD_SIZE, maxX=-1, maxY=-1;
-    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j) if(b[i][j]!=0){
-        minX=std::min(minX,i); minY=std::min(minY,j); maxX=std::max(maxX,i); maxY=std::max(maxY,j);
     }
-    minX = std::max(0, minX-radius); minY = std::max(0, minY-radius);
-    maxX = std::min(BOARD_SIZE-1, maxX+radius); maxY = std::min(BOARD_SIZE-1, maxY+radius);
-
-    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
-
-    // 收集空位
-    for(int i=minX;i<=maxX;++i){
-        for(int j=minY;j<=maxY;++j){
-            if(b[i][j]==0){
-                // 即胜与必防优先
-                if(makesFive(b,i,j,1)) { out.push_back({i,j, SCORE_FIVE}); continue; }
-                if(makesFive(b,i,j,2)) { out.push_back({i,j, SCORE_OPEN_FOUR*4}); continue; }
-
-                // 方向启发：统计开四/活三/眠三等
-                int score = 0;
-                // 进攻（黑）
-                for(auto &d:DIRS){
-                    LineInfo li = lineInfoAfter(b,i,j,1,d[0],d[1]);
-                    if(li.count==4 && li.openEnds>=1) score += SCORE_OPEN_FOUR/2; // 近似
-                    else if(li.count==3 && li.openEnds==2) score += SCORE_OPEN_THREE;
-                    else if(li.count==3 && li.openEnds==1) score += SCORE_BLOCKED_THREE/2;
-                    else if(li.count==2 && li.openEnds==2) score += SCORE_OPEN_TWO/2;
-                }
-                // 防守（白）
-                for(auto &d:DIRS){
-                    LineInfo li = lineInfoAfter(b,i,j,2,d[0],d[1]);
-                    if(li.count==4 && li.openEnds>=1) score += SCORE_OPEN_FOUR/2; // 优先堵四
-                    else if(li.count==3 && li.openEnds==2) score += SCORE_OPEN_THREE/2;
-                }
-                // 再加粗略潜力
-                score += quickHeuristic(b,i,j,1) + quickHeuristic(b,i,j,2)/2;
-                out.push_back({i,j,score});
-            }
+    if(qdepth<=0 || moves.empty()) return standPat;
+    if(ctx.shouldStop()) return standPat;
+
+    int bestVal = mustBlock ? ((player==1)? INT_MIN : INT_MAX) : standPat;
+    for(auto &m: moves){
+        b[m.x][m.y]=player; ctx.threats.update(b,m.x,m.y);
+        int val = quiescence(b, alpha, beta, (player==1)?2:1, m.x, m.y, qdepth-1, ctx);
+        b[m.x][m.y]=0; ctx.threats.update(b,m.x,m.y);
+        if(player==1){
+            if(val>bestVal) bestVal=val;
+            alpha = std::max(alpha, val);
+        } else {
+            if(val<bestVal) bestVal=val;
+            beta = std::min(beta, val);
         }
+        if(beta<=alpha) break;
     }
-    // 排序（降序）
-    std::ranges::sort(out, [](const Move&a,const Move&b){ return a.score>b.score; });
-    // 限制最大分支（可调）
-    constexpr size_t MAX_BRANCH = 40; // 控制分支数量
-    if(out.size()>MAX_BRANCH) out.resize(MAX_BRANCH);
+    return bestVal;
 }
 
 static int alphabeta(int b[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int beta, int player,
-                     int lastX, int lastY, std::chrono::steady_clock::time_point deadline, uint64_t currentHash){
-    if(depth<=0){ return evaluate(b); }
-    // 超时检测
-    if(std::chrono::steady_clock::now() > deadline){ return evaluate(b); }
+                     int lastX, int lastY, SearchContext& ctx, uint64_t currentHash){
+    if(depth<=0){ return quiescence(b, alpha, beta, player, lastX, lastY, QS_MAX_DEPTH, ctx); }
+    GOMOKU_PROFILE_SCOPE(PF_ALPHABETA);
+    ++ctx.stats.nodes;
+    // 超时 / 节点预算检测
+    if(ctx.shouldStop()){ return evaluate(b); }
     // 终局：上一手形成胜利
     if(inBoard2(lastX,lastY) && isWin(b,lastX,lastY)){
         int winScore = (b[lastX][lastY]==1)? SCORE_FIVE : -SCORE_FIVE;
@@ -342,37 +153,100 @@ static int alphabeta(int b[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int be
 
     // TT Lookup
     int ttIndex = currentHash & TT_MASK;
-    if(TRANS_TABLE[ttIndex].hash == currentHash && TRANS_TABLE[ttIndex].depth >= depth){
-        return TRANS_TABLE[ttIndex].value;
+    int hashMove = -1;
+    {
+        GOMOKU_PROFILE_SCOPE(PF_TT_PROBE);
+        const TTEntry& e = TRANS_TABLE[ttIndex];
+        if(e.hash == currentHash){
+            hashMove = e.bestMove;
+            if(e.depth >= depth){
+                if(e.flag==TT_EXACT) return e.value;
+                if(e.flag==TT_LOWER && e.value>=beta) return e.value;
+                if(e.flag==TT_UPPER && e.value<=alpha) return e.value;
+            }
+        }
+    }
+    // TT 未命中时查持久化缓存（只存精确值），命中则回填 TT
+    if(ctx.cache && depth>=CACHE_MIN_DEPTH && hashMove<0){
+        CacheEntry ce;
+        if(ctx.cache->probe(currentHash, ce)){
+            ++ctx.stats.cacheHits;
+            int cachedMove = (ce.bestMove==SearchCache::NO_MOVE)? -1 : ce.bestMove;
+            if(ce.depth >= depth){
+                TRANS_TABLE[ttIndex] = {currentHash, ce.value, (int8_t)ce.depth, TT_EXACT, (int16_t)cachedMove};
+                return ce.value;
+            }
+            hashMove = cachedMove;
+        }
     }
 
-    std::vector<Move> moves; genMoves(b, moves, 2);
+    std::vector<Move> moves;
+    if(genMoves(b, ctx.threats, player, moves, 2, ctx.options.forcedMoves)) ++ctx.stats.forcedGens;
     if(moves.empty()) return evaluate(b);
+    promoteMove(moves, hashMove);
+
+    const int alphaOrig = alpha, betaOrig = beta;
+    int bestIdx = -1;
 
     int bestVal = (player==1)? INT_MIN : INT_MAX;
 
+    // 无益剪枝：静态分加上余量仍无法越过窗口时，非威胁着法不再搜索
+    bool futile=false;
+    int staticEval=0;
+    if(ctx.options.futilityPruning && depth<=FUTILITY_DEPTH){
+        staticEval = evaluate(b);
+        futile = (player==1) ? (staticEval + FUTILITY_MARGIN[depth] <= alpha)
+                             : (staticEval - FUTILITY_MARGIN[depth] >= beta);
+    }
+
     for(size_t i=0;i<moves.size(); ++i){
         int x=moves[i].x, y=moves[i].y;
-        b[x][y]=player;
+        bool quiet = !isThreatMove(moves[i], player, ctx.threats);
+        if(futile && quiet && i>0){
+            ++ctx.stats.futilityPrunes;
+            bestVal = (player==1) ? std::max(bestVal, staticEval) : std::min(bestVal, staticEval);
+            continue;
+        }
+        b[x][y]=player; ctx.threats.update(b,x,y);
         uint64_t nextHash = currentHash ^ ZOBRIST[x][y][player];
-        int val = alphabeta(b, depth-1, alpha, beta, (player==1)?2:1, x, y, deadline, nextHash);
-        b[x][y]=0;
+        int val;
+        if(ctx.options.lateMoveReduction && quiet && depth>=LMR_MIN_DEPTH && i>=LMR_FULL_MOVES){
+            // 后序低分着法先减一层搜索，结果能改善窗口时再全深度重搜
+            ++ctx.stats.lmrReductions;
+            val = alphabeta(b, depth-2, alpha, beta, (player==1)?2:1, x, y, ctx, nextHash);
+            bool failHigh = (player==1) ? (val>alpha) : (val<beta);
+            if(failHigh){
+                ++ctx.stats.lmrResearches;
+                val = alphabeta(b, depth-1, alpha, beta, (player==1)?2:1, x, y, ctx, nextHash);
+            }
+        } else {
+            val = alphabeta(b, depth-1, alpha, beta, (player==1)?2:1, x, y, ctx, nextHash);
+        }
+        b[x][y]=0; ctx.threats.update(b,x,y);
         if(player==1){ // Maximizer (黑)
-            if(val>bestVal) bestVal=val;
+            if(val>bestVal){ bestVal=val; bestIdx=(int)i; }
             alpha = std::max(alpha, val);
             if(beta<=alpha) break; // 剪枝
         } else { // Minimizer (白)
-            if(val<bestVal) bestVal=val;
+            if(val<bestVal){ bestVal=val; bestIdx=(int)i; }
             beta = std::min(beta, val);
             if(beta<=alpha) break; // 剪枝
         }
     }
-    // TT Store
-    TRANS_TABLE[ttIndex] = {currentHash, bestVal, depth};
+    if(ctx.stopped) return bestVal;
+    // TT Store：按原始窗口区分精确值与上下界
+    TTFlag flag = (bestVal<=alphaOrig)? TT_UPPER : (bestVal>=betaOrig)? TT_LOWER : TT_EXACT;
+    int best = (bestIdx>=0)? moves[bestIdx].x*BOARD_SIZE + moves[bestIdx].y : -1;
+    TRANS_TABLE[ttIndex] = {currentHash, bestVal, (int8_t)depth, flag, (int16_t)best};
+    if(ctx.cache && flag==TT_EXACT && depth>=CACHE_MIN_DEPTH) ctx.cache->record(currentHash, bestVal, depth, best);
     return bestVal;
 }
 
 std::pair<int,int> AlphaBeta::getBestMove(const int (*board)[15]) {
+    return getBestMove(board, SearchLimits{});
+}
+
+std::pair<int,int> AlphaBeta::getBestMove(const int (*board)[15], const SearchLimits& limits) {
     initZobrist();
     int b[BOARD_SIZE][BOARD_SIZE];
     std::memcpy(b, board, sizeof(int)*BOARD_SIZE*BOARD_SIZE);
@@ -383,36 +257,69 @@ std::pair<int,int> AlphaBeta::getBestMove(const int (*board)[15]) {
     int turn = inferTurn(b);
     if(turn!=1){ return {-1,-1}; } // 若当前不是黑棋回合，返回占位让 UI 跳过
 
+    // 确定性模式：清空置换表、绕开持久化缓存，结果只取决于局面与预算
+    const bool deterministic = limits.nodes>0 || limits.depth>0;
+    if(deterministic) std::memset(TRANS_TABLE, 0, sizeof(TRANS_TABLE));
+    SearchCache* cache = deterministic ? nullptr : cache_;
+
     auto start = std::chrono::steady_clock::now();
     auto deadline = start + (std::chrono::milliseconds)(long long)timeLimitMs_;
+    SearchContext ctx{deadline, !deterministic, limits.nodes, options_, cache, {}, {}};
     uint64_t rootHash = computeHash(b);
+    ctx.threats.rebuild(b);
 
     std::pair<int,int> bestMove={-1,-1};
     int bestScore = INT_MIN;
+    int bestDepth = 0; // bestMove / bestScore 出自哪一层迭代
+    int startDepth = 1;
 
     // 迭代加深
-    constexpr int MAX_DEPTH = 10; // 可调或根据时间动态调整
-    for(int depth=1; depth<=MAX_DEPTH; ++depth){
-        if(std::chrono::steady_clock::now() > deadline) break; // 超时退出
-        std::vector<Move> moves; genMoves(b, moves, neighborhoodRadius_);
+    const int MAX_DEPTH = (limits.depth>0) ? std::min(limits.depth, 10) : 10; // 可调或根据时间动态调整
+    // 热启动：缓存里已有该局面的深层结果时，直接从更深一层继续
+    CacheEntry rootEntry;
+    if(cache && cache->probe(rootHash, rootEntry) && rootEntry.bestMove!=SearchCache::NO_MOVE
+       && b[rootEntry.bestMove/BOARD_SIZE][rootEntry.bestMove%BOARD_SIZE]==0){
+        ++ctx.stats.cacheHits;
+        bestMove = {rootEntry.bestMove/BOARD_SIZE, rootEntry.bestMove%BOARD_SIZE};
+        bestScore = rootEntry.value;
+        bestDepth = rootEntry.depth;
+        ctx.stats.depth = rootEntry.depth;
+        startDepth = rootEntry.depth + 1;
+    }
+    for(int depth=startDepth; depth<=MAX_DEPTH; ++depth){
+        if(ctx.shouldStop()) break; // 超时 / 预算用尽退出
+        if(bestScore >= SCORE_OPEN_FOUR) break; // 缓存中已有必杀
+        std::vector<Move> moves;
+        if(genMoves(b, ctx.threats, 1, moves, neighborhoodRadius_, ctx.options.forcedMoves)) ++ctx.stats.forcedGens;
         if(moves.empty()) break;
+        if(bestMove.first>=0) promoteMove(moves, bestMove.first*BOARD_SIZE + bestMove.second);
         int localBestScore = INT_MIN; std::pair<int,int> localBestMove = bestMove;
         for(auto &m: moves){
-            if(std::chrono::steady_clock::now() > deadline) break;
-            b[m.x][m.y]=1; // 黑试探
+            if(ctx.shouldStop()) break;
+            b[m.x][m.y]=1; ctx.threats.update(b,m.x,m.y); // 黑试探
             uint64_t nextHash = rootHash ^ ZOBRIST[m.x][m.y][1];
-            int val = alphabeta(b, depth-1, INT_MIN/2, INT_MAX/2, 2, m.x, m.y, deadline, nextHash); // 下一层白
-            b[m.x][m.y]=0;
+            int val = alphabeta(b, depth-1, INT_MIN/2, INT_MAX/2, 2, m.x, m.y, ctx, nextHash); // 下一层白
+            b[m.x][m.y]=0; ctx.threats.update(b,m.x,m.y);
             if(val > localBestScore){ localBestScore=val; localBestMove={m.x,m.y}; }
         }
-        if(std::chrono::steady_clock::now() <= deadline){
-            if(localBestScore > bestScore){ bestScore=localBestScore; bestMove=localBestMove; }
+        if(!ctx.stopped){
+            if(localBestScore > bestScore){ bestScore=localBestScore; bestMove=localBestMove; bestDepth=depth; }
+            ctx.stats.depth = depth;
         }
         // 若已找到确定胜利（高分）提前跳出
         if(bestScore >= SCORE_OPEN_FOUR) break; // 已有必杀高价值
     }
+    // 根局面记录实际返回的着法及其所在层的分数，保证热启动与冷启动走同一步
+    if(cache && bestDepth>=CACHE_MIN_DEPTH && bestMove.first>=0){
+        cache->record(rootHash, bestScore, bestDepth, bestMove.first*BOARD_SIZE + bestMove.second);
+    }
+    stats_ = ctx.stats;
+    // 周期性落盘：放在两次搜索之间，不占用思考时间
+    if(cache && cache->pendingCount() >= CACHE_FLUSH_PENDING) cache->flush();
 
-    if(bestMove.first<0) { // 兜底：返回第一个空位
+    if(bestMove.first<0) { // 兜底：取启发排序最高的着法，其次第一个空位
+        std::vector<Move> moves; genMoves(b, moves, neighborhoodRadius_);
+        if(!moves.empty()) return {moves[0].x, moves[0].y};
         for(int i=0;i<BOARD_SIZE;++i){ for(int j=0;j<BOARD_SIZE;++j){ if(b[i][j]==0) return {i,j}; } }
         return {-1,-1};
     }
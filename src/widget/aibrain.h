@@ -3,6 +3,34 @@
 
 #include <utility>
 
+class SearchCache;
+
+// 单次搜索的统计信息（节点数等），供调参与对比测试使用
+struct SearchStats {
+    long long nodes = 0;    // 主搜索（alphabeta）节点数
+    long long qnodes = 0;   // 静态搜索（quiescence）节点数，单独计数
+    int depth = 0;          // 迭代加深完成的最大深度
+    long long lmrReductions = 0;   // 后序着法减深搜索次数
+    long long lmrResearches = 0;   // 减深结果越界后的全深度重搜次数
+    long long futilityPrunes = 0;  // 叶子附近被无益剪枝跳过的着法数
+    long long cacheHits = 0;       // 持久化缓存命中次数
+    long long forcedGens = 0;      // 因存在威胁而只生成强制应对的节点数
+};
+
+// 搜索终止条件：0 表示不限。nodes 或 depth 任一非 0 即为确定性模式——
+// 不看墙钟、不读写持久化缓存、每次搜索前清空置换表，同一局面重复搜索得到逐位相同的着法与节点数
+struct SearchLimits {
+    long long nodes = 0;  // 主搜索 + 静态搜索节点总预算
+    int depth = 0;        // 迭代加深的最大深度
+};
+
+// 选择性搜索开关：可单独关闭，用于对比节省的节点数与对局结果
+struct SearchOptions {
+    bool lateMoveReduction = true;  // 后序着法减深（LMR）
+    bool futilityPruning = true;    // 叶子附近的无益剪枝
+    bool forcedMoves = true;        // 存在威胁时只生成强制应对
+};
+
 class AIBrain {
 public:
     virtual ~AIBrain() = default;
@@ -21,6 +49,18 @@ public:
     ~AlphaBeta() override = default;
 
     std::pair<int,int> getBestMove(const int (*board)[15]) override;
+    // 按给定节点 / 深度预算搜索；limits 全为 0 时等同于按时间限制搜索
+    std::pair<int,int> getBestMove(const int (*board)[15], const SearchLimits& limits);
+
+    // 最近一次 getBestMove 的搜索统计
+    const SearchStats& lastStats() const { return stats_; }
+
+    // 选择性搜索开关
+    const SearchOptions& options() const { return options_; }
+    void setOptions(const SearchOptions& opts) { options_ = opts; }
+
+    // 可选的持久化搜索缓存（由调用方持有；nullptr 表示关闭）
+    void setCache(SearchCache* cache) { cache_ = cache; }
 
 private:
     int timeLimitMs_;
@@ -28,6 +68,9 @@ private:
     double c_;
     bool useNeighborhood_;
     int neighborhoodRadius_;
+    SearchStats stats_;
+    SearchOptions options_;
+    SearchCache* cache_ = nullptr;
 
     int computeTimeBudget(const int board[15][15]) const;
 };
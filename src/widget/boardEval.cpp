@@ -0,0 +1,576 @@
+#include "boardEval.h"
+#include "profile.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <random>
+
+// Zobrist 哈希表
+uint64_t ZOBRIST[BOARD_SIZE][BOARD_SIZE][3]; // 0 unused, 1 black, 2 white
+static bool ZOB_INIT = false;
+
+void initZobrist(){
+    if(ZOB_INIT) return;
+    std::mt19937_64 rng(0xC0FFEE123456789ULL); // 固定种子保证复现
+    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
+        for(int c=0;c<3;++c){ ZOBRIST[i][j][c] = rng(); }
+    }
+    ZOB_INIT = true;
+}
+
+uint64_t zobristFingerprint(){
+    initZobrist();
+    return ZOBRIST[0][0][1] ^ ZOBRIST[BOARD_SIZE/2][BOARD_SIZE/2][2] ^ ZOBRIST[BOARD_SIZE-1][BOARD_SIZE-1][1];
+}
+
+uint64_t computeHash(const int b[BOARD_SIZE][BOARD_SIZE]){
+    uint64_t h=0;
+    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
+        int v=b[i][j]; if(v) h ^= ZOBRIST[i][j][v];
+    }
+    return h;
+}
+
+// 检测胜利：从 (x,y) 出发四个方向统计连续同色
+bool isWin(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y){
+    GOMOKU_PROFILE_SCOPE(PF_IS_WIN);
+    if(!inBoard2(x,y) || b[x][y]==0) return false;
+    int color=b[x][y];
+    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
+    for(auto &d:DIRS){
+        int cnt=1;
+        int dx=d[0], dy=d[1];
+        int nx=x+dx, ny=y+dy;
+        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
+        nx=x-dx; ny=y-dy;
+        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
+        if(cnt>=5) return true;
+    }
+    return false;
+}
+
+bool isDraw(const int b[BOARD_SIZE][BOARD_SIZE]){
+    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j) if(b[i][j]==0) return false;
+    return true;
+}
+
+// 在一条线（指针+步长）中统计给定颜色的各种模式
+void countPatternsLine(const int* start, int stride, int length, int color, PatternCount &pc){
+    // 五连、四连、三连、二连模式识别涉及到空位边界
+    for(int i=0;i<length;++i){
+        // Helper lambda for strided access
+        auto at = [&](int idx) { return *(start + idx * stride); };
+        // 跳过空减少一些冗余
+        // 直接五连
+        if(i+4<length){
+            bool five=true; for(int k=0;k<5;++k) if(at(i+k)!=color){ five=false; break; }
+            if(five){ pc.five++; continue; }
+        }
+        // 检查 6 长度窗口用于开放端判断
+        if(i+5<length){
+            // 活四: 0 C C C C 0 (中间四个, 两端空)
+            if(at(i)==0 && at(i+5)==0){
+                int cnt=0; for(int k=1;k<=4;++k) if(at(i+k)==color) ++cnt; else break; if(cnt==4) pc.o4++; // 0CCCC0
+            }
+            // 冲四（阻塞四）: 0 C C C C X 或 X C C C C 0 （一端空一端非空）
+            // 或 C C C C 0 X / X 0 C C C C 等扩展——简化：窗口中含恰好四个连续 color + 至少一端空另一端非空
+            int cCnt=0; for(int k=0;k<6;++k) if(at(i+k)==color) cCnt++;
+            if(cCnt==4){
+                // 统计端点情况
+                bool leftEmpty = at(i)==0; bool rightEmpty = at(i+5)==0;
+                bool leftBlocked = (!leftEmpty && at(i)!=color);
+                bool rightBlocked = (!rightEmpty && at(i+5)!=color);
+                if((leftEmpty && rightBlocked) || (rightEmpty && leftBlocked)) pc.b4++; // 一端空一端被阻
+            }
+        }
+
+        if(i+5<length){
+            // 6 长度
+            // 活三模式简化：0 C C C 0 0, 0 0 C C C 0, 0 C C 0 C 0 等更复杂；这里采取枚举出现 "0 C C C 0" 子串并保证两侧至少一个额外空
+            // 用更保守实现：匹配子串 0 C C C 0 且周围再有一个空位 -> 活三，否则眠三
+            bool pattern=true; if(at(i)==0 && at(i+4)==0){ for(int k=1;k<=3;++k) if(at(i+k)!=color){ pattern=false; break; } }
+            else pattern=false;
+            if(pattern){
+                bool extraLeft = (i-1>=0 && at(i-1)==0);
+                bool extraRight = (i+5<length && at(i+5)==0);
+                if(extraLeft || extraRight) pc.o3++; else pc.b3++;
+            }
+        }
+        if(i+4<length){
+            // 5 长度窗口用于眠三/活二等简化识别
+            // 眠三候选： C C C 0 X / X 0 C C C / 0 C C C X / X C C C 0 等——简化：窗口内有3个 color, 其余有一个空，一个阻塞
+            int cCnt=0, emptyCnt=0; for(int k=0;k<5;++k){ int v=at(i+k); if(v==color) cCnt++; else if(v==0) emptyCnt++; }
+            if(cCnt==3 && emptyCnt==2){
+                // 如果两个空分布在两端则更像活三，已经上面识别；否则归为眠三
+                bool endsEmpty = (at(i)==0 && at(i+4)==0);
+                if(!endsEmpty) pc.b3++;
+            }
+            // 活二：0 C C 0 0 或 0 0 C C 0 或 0 C 0 C 0
+            if(cCnt==2 && emptyCnt>=3){
+                bool endsEmpty = (at(i)==0 && at(i+4)==0);
+                if(endsEmpty) pc.o2++; else pc.b2++;
+            }
+        }
+    }
+}
+
+int evaluate(const int b[BOARD_SIZE][BOARD_SIZE]){
+    GOMOKU_PROFILE_SCOPE(PF_EVALUATE);
+    // 终局快速检测（高权重）
+    // 若存在直接五连返回极值避免继续
+    // 全面扫描
+    PatternCount blackCount, whiteCount;
+
+    // Get raw pointer for strided access
+    const int* ptr = &b[0][0];
+
+    // 横向
+    for(int i=0;i<BOARD_SIZE;++i){
+        countPatternsLine(ptr + i*BOARD_SIZE, 1, BOARD_SIZE, 1, blackCount);
+        countPatternsLine(ptr + i*BOARD_SIZE, 1, BOARD_SIZE, 2, whiteCount);
+    }
+    // 纵向
+    for(int j=0;j<BOARD_SIZE;++j){
+        countPatternsLine(ptr + j, BOARD_SIZE, BOARD_SIZE, 1, blackCount);
+        countPatternsLine(ptr + j, BOARD_SIZE, BOARD_SIZE, 2, whiteCount);
+    }
+    // 主对角线族
+    // k=0: (0,0) -> (14,14)
+    countPatternsLine(ptr, BOARD_SIZE+1, BOARD_SIZE, 1, blackCount);
+    countPatternsLine(ptr, BOARD_SIZE+1, BOARD_SIZE, 2, whiteCount);
+
+    for(int k=1;k<BOARD_SIZE;++k){
+        // 上三角: (0,k) -> (14-k, 14)
+        int len = BOARD_SIZE - k;
+        if(len>=5){
+             countPatternsLine(ptr + k, BOARD_SIZE+1, len, 1, blackCount);
+             countPatternsLine(ptr + k, BOARD_SIZE+1, len, 2, whiteCount);
+        }
+        // 下三角: (k,0) -> (14, 14-k)
+        if(len>=5){
+             countPatternsLine(ptr + k*BOARD_SIZE, BOARD_SIZE+1, len, 1, blackCount);
+             countPatternsLine(ptr + k*BOARD_SIZE, BOARD_SIZE+1, len, 2, whiteCount);
+        }
+    }
+    // 副对角线族
+    for(int k=0;k<BOARD_SIZE;++k){
+        int len = k+1;
+        if(len>=5){
+            countPatternsLine(ptr + k, BOARD_SIZE-1, len, 1, blackCount);
+            countPatternsLine(ptr + k, BOARD_SIZE-1, len, 2, whiteCount);
+        }
+    }
+    for(int k=1;k<BOARD_SIZE;++k){
+        int len = BOARD_SIZE - k;
+        if(len>=5){
+            countPatternsLine(ptr + k*BOARD_SIZE + (BOARD_SIZE-1), BOARD_SIZE-1, len, 1, blackCount);
+            countPatternsLine(ptr + k*BOARD_SIZE + (BOARD_SIZE-1), BOARD_SIZE-1, len, 2, whiteCount);
+        }
+    }
+
+    // 即胜直接返回
+    if(blackCount.five>0) return SCORE_FIVE; // 极大正分
+    if(whiteCount.five>0) return -SCORE_FIVE;
+
+    auto scoreSide=[&](const PatternCount &pc){
+        long long s=0;
+        s += (long long)pc.five * SCORE_FIVE;
+        s += (long long)pc.o4 * SCORE_OPEN_FOUR;
+        s += (long long)pc.b4 * SCORE_BLOCKED_FOUR;
+        s += (long long)pc.o3 * SCORE_OPEN_THREE;
+        s += (long long)pc.b3 * SCORE_BLOCKED_THREE;
+        s += (long long)pc.o2 * SCORE_OPEN_TWO;
+        s += (long long)pc.b2 * SCORE_BLOCKED_TWO;
+        // 单子：约略统计棋盘上该颜色子数用于微调
+        // 这里不再额外扫描，简单按模式权重即可
+        return (int)s;
+    };
+    int blackScore = scoreSide(blackCount);
+    int whiteScore = scoreSide(whiteCount);
+    return blackScore - whiteScore; // 黑优为正
+}
+
+// 局部快速打分：为走法排序（不需要全面模式统计）
+static int quickHeuristic(const int b[BOARD_SIZE][BOARD_SIZE], int x,int y, int color){
+    // 检查四个方向最大连续潜力 (包含当前落子) 作为粗启发
+    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
+    int total=0;
+    for(auto &d:DIRS){
+        int dx=d[0],dy=d[1];
+        int cnt=1; // 包含自己
+        int nx=x+dx, ny=y+dy;
+        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
+        nx=x-dx; ny=y-dy;
+        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
+        total += cnt*cnt; // 二次加权
+    }
+    return total;
+}
+
+// 在不落子的情况下判断：若把 'color' 落在 (x,y) 是否形成五连
+bool makesFive(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int color){
+    if(!inBoard2(x,y) || b[x][y]!=0) return false;
+    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
+    for(auto &d:DIRS){
+        int dx=d[0], dy=d[1];
+        int cnt=1; // 计入当前假设落子
+        int nx=x+dx, ny=y+dy;
+        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
+        nx=x-dx; ny=y-dy;
+        while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
+        if(cnt>=5) return true;
+    }
+    return false;
+}
+
+LineInfo lineInfoAfter(const int b[BOARD_SIZE][BOARD_SIZE], int x,int y,int color,int dx,int dy){
+    // 统计以 (x,y) 假设为 color 时，在方向(dx,dy)的连续数量及开放端数
+    int cnt=1; int open=0;
+    int nx=x+dx, ny=y+dy;
+    while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx+=dx; ny+=dy; }
+    if(inBoard2(nx,ny) && b[nx][ny]==0) ++open;
+    nx=x-dx; ny=y-dy;
+    while(inBoard2(nx,ny) && b[nx][ny]==color){ ++cnt; nx-=dx; ny-=dy; }
+    if(inBoard2(nx,ny) && b[nx][ny]==0) ++open;
+    return {cnt, open};
+}
+
+static constexpr int THREAT_DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
+
+// 窗口扫描：v 为某方向上以候选点为中心、偏移 -5..5 的 11 格（界外记为 3，视同对方子），
+// 假设 color 落在中心，检查所有包含中心的 5 格 / 6 格窗口。
+// 返回值：WIN_FIVE 表示成五；WIN_THREE 表示成活三；低 3 位为成五点个数（包含中心的窗口内 4 子 + 1 空）
+static constexpr uint8_t WIN_FIVE = 0x80, WIN_THREE = 0x40, WIN_POINTS = 0x07;
+static constexpr int OFF_BOARD = 3;
+static uint8_t scanWindows(const int* v, int color){
+    // 前缀计数：own[k] / empty[k] 为 v[0..k) 中本色 / 空位数，中心按本色计
+    int own[12], empty[12];
+    own[0]=empty[0]=0;
+    for(int k=0;k<11;++k){
+        int c = (k==5) ? color : v[k];
+        own[k+1] = own[k] + (c==color);
+        empty[k+1] = empty[k] + (c==0);
+    }
+    if(own[11] < 3) return 0; // 连同中心不足 3 子，构不成任何棋型
+    uint8_t r=0;
+    unsigned points=0; // 成五点所在偏移的位集，去重
+    for(int s=1;s<=5;++s){ // 5 格窗口 [s, s+4]
+        int cnt = own[s+5]-own[s];
+        if(cnt==5) r |= WIN_FIVE;
+        else if(cnt==4 && empty[s+5]-empty[s]==1){
+            for(int k=s;k<s+5;++k) if(k!=5 && v[k]==0) points |= 1u<<k;
+        }
+    }
+    for(int s=0;s<=4;++s){ // 6 格窗口 [s, s+5]：两端空，中间 4 格 3 子 1 空
+        if(v[s]!=0 || v[s+5]!=0) continue;
+        if(own[s+5]-own[s+1]==3 && empty[s+5]-empty[s+1]==1){ r |= WIN_THREE; break; }
+    }
+    return r | (uint8_t)std::min(std::popcount(points), (int)WIN_POINTS);
+}
+
+// 取 (x,y) 沿方向 dir 偏移 -reach..reach 的格子
+static void loadLine(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int dir, int reach, int* v){
+    int dx=THREAT_DIRS[dir][0], dy=THREAT_DIRS[dir][1];
+    for(int k=-reach;k<=reach;++k){
+        int nx=x+k*dx, ny=y+k*dy;
+        v[k+reach] = inBoard2(nx,ny) ? b[nx][ny] : OFF_BOARD;
+    }
+}
+
+// 由四个方向的窗口扫描结果汇总威胁标记；不同方向上的成五点必然是不同的格子，可直接相加
+static uint8_t threatFlags(const uint8_t win[4]){
+    uint8_t f=0;
+    int points=0;
+    for(int d=0;d<4;++d){
+        if(win[d] & WIN_FIVE) f |= ThreatMap::T_FIVE;
+        if(win[d] & WIN_THREE) f |= ThreatMap::T_OPEN_THREE;
+        points += win[d] & WIN_POINTS;
+    }
+    if(points>=1) f |= ThreatMap::T_FOUR;
+    if(points>=2) f |= ThreatMap::T_OPEN_FOUR;
+    return f;
+}
+
+void ThreatMap::refresh(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int dir){
+    int v[11];
+    loadLine(b,x,y,dir,5,v);
+    refresh(b,x,y,dir,v,true);
+}
+
+void ThreatMap::refresh(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int dir, const int* v, bool lineChanged){
+    for(int c=0;c<2;++c){
+        uint8_t* line = line_[c][x][y];
+        uint8_t* win = window_[c][x][y];
+        if(b[x][y]==0){
+            if(lineChanged){
+                LineInfo li = lineInfoAfter(b,x,y,c+1,THREAT_DIRS[dir][0],THREAT_DIRS[dir][1]);
+                line[dir] = (uint8_t)((li.count<<2) | li.openEnds);
+            }
+            win[dir] = scanWindows(v,c+1);
+        } else {
+            line[dir] = 0;
+            win[dir] = 0;
+        }
+        uint8_t f = (b[x][y]==0) ? threatFlags(win) : 0;
+        uint8_t changed = f ^ flags_[c][x][y];
+        for(int k=0;k<4;++k){
+            if(changed & (1u<<k)) counts_[c][k] += (f & (1u<<k)) ? 1 : -1;
+        }
+        flags_[c][x][y] = f;
+    }
+}
+
+void ThreatMap::rebuild(const int b[BOARD_SIZE][BOARD_SIZE]){
+    *this = ThreatMap{};
+    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j) if(b[i][j]==0){
+        for(int d=0;d<4;++d) refresh(b,i,j,d);
+    }
+}
+
+void ThreatMap::update(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y){
+    // 窗口扫描只读到 5 格以内；lineInfoAfter 读到"同色连续段 + 段外一格"，可能更远。
+    // 因此每个方向上重算距离 5 以内的空位，以及越过一段同色子后的第一个空位。
+    // 该方向的格子先整段读入，各空位的窗口直接在缓冲上扫描
+    constexpr int REACH = 10;
+    int v[2*REACH+1];
+    for(int d=0;d<4;++d){
+        int dx=THREAT_DIRS[d][0], dy=THREAT_DIRS[d][1];
+        loadLine(b,x,y,d,REACH,v);
+        refresh(b,x,y,d,v+REACH-5,true);
+        for(int s=-1;s<=1;s+=2){
+            // 越过一段同色子（可为空段）后的第一个格子：只有它的 lineInfoAfter 会变
+            int run=v[REACH+s], runEnd=1;
+            while(run!=0 && run!=OFF_BOARD && runEnd<=REACH && v[REACH+s*runEnd]==run) ++runEnd;
+            for(int k=1;k<=5;++k){
+                int off=REACH+s*k;
+                if(v[off]==OFF_BOARD) break;
+                if(v[off]==0) refresh(b,x+s*k*dx,y+s*k*dy,d,v+off-5,k==runEnd);
+            }
+            if(runEnd>5){
+                int nx=x+s*runEnd*dx, ny=y+s*runEnd*dy;
+                if(inBoard2(nx,ny) && b[nx][ny]==0) refresh(b,nx,ny,d);
+            }
+        }
+    }
+}
+
+// 候选区域：棋子包围盒向外扩 radius；空盘返回 false
+static bool candidateBounds(const int b[BOARD_SIZE][BOARD_SIZE], int radius, int& minX, int& minY, int& maxX, int& maxY){
+    minX=BOARD_SIZE; minY=BOARD_SIZE; maxX=-1; maxY=-1;
+    for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j) if(b[i][j]!=0){
+        minX=std::min(minX,i); minY=std::min(minY,j); maxX=std::max(maxX,i); maxY=std::max(maxY,j);
+    }
+    if(maxX<0) return false;
+    minX = std::max(0, minX-radius); minY = std::max(0, minY-radius);
+    maxX = std::min(BOARD_SIZE-1, maxX+radius); maxY = std::min(BOARD_SIZE-1, maxY+radius);
+    return true;
+}
+
+// 候选走法排序并截断分支
+static void sortAndTrim(std::vector<Move>& out){
+    // 排序（降序）
+    std::ranges::sort(out, [](const Move&a,const Move&b){ return a.score>b.score; });
+    // 限制最大分支（可调）
+    constexpr size_t MAX_BRANCH = 40; // 控制分支数量
+    if(out.size()>MAX_BRANCH) out.resize(MAX_BRANCH);
+}
+
+void genMoves(const int b[BOARD_SIZE][BOARD_SIZE], std::vector<Move>& out, int radius){
+    GOMOKU_PROFILE_SCOPE(PF_GEN_MOVES);
+    out.clear();
+    int minX, minY, maxX, maxY;
+    if(!candidateBounds(b, radius, minX, minY, maxX, maxY)){ out.push_back({BOARD_SIZE/2, BOARD_SIZE/2, 0}); return; }
+
+    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
+
+    // 收集空位
+    for(int i=minX;i<=maxX;++i){
+        for(int j=minY;j<=maxY;++j){
+            if(b[i][j]==0){
+                // 即胜与必防优先
+                if(makesFive(b,i,j,1)) { out.push_back({i,j, SCORE_FIVE}); continue; }
+                if(makesFive(b,i,j,2)) { out.push_back({i,j, SCORE_OPEN_FOUR*4}); continue; }
+
+                // 方向启发：统计开四/活三/眠三等
+                int score = 0;
+                // 进攻（黑）
+                for(auto &d:DIRS){
+                    LineInfo li = lineInfoAfter(b,i,j,1,d[0],d[1]);
+                    if(li.count==4 && li.openEnds>=1) score += SCORE_OPEN_FOUR/2; // 近似
+                    else if(li.count==3 && li.openEnds==2) score += SCORE_OPEN_THREE;
+                    else if(li.count==3 && li.openEnds==1) score += SCORE_BLOCKED_THREE/2;
+                    else if(li.count==2 && li.openEnds==2) score += SCORE_OPEN_TWO/2;
+                }
+                // 防守（白）
+                for(auto &d:DIRS){
+                    LineInfo li = lineInfoAfter(b,i,j,2,d[0],d[1]);
+                    if(li.count==4 && li.openEnds>=1) score += SCORE_OPEN_FOUR/2; // 优先堵四
+                    else if(li.count==3 && li.openEnds==2) score += SCORE_OPEN_THREE/2;
+                }
+                // 再加粗略潜力
+                score += quickHeuristic(b,i,j,1) + quickHeuristic(b,i,j,2)/2;
+                out.push_back({i,j,score});
+            }
+        }
+    }
+    sortAndTrim(out);
+}
+
+// 与上面的逐格打分一致，只是各方向的连续数/开放端改为查表
+static int scoreFromMap(const ThreatMap& tm, int x, int y){
+    if(tm.flags(1,x,y) & ThreatMap::T_FIVE) return SCORE_FIVE;
+    if(tm.flags(2,x,y) & ThreatMap::T_FIVE) return SCORE_OPEN_FOUR*4;
+    int score=0, quick1=0, quick2=0;
+    for(int d=0;d<4;++d){
+        LineInfo li = tm.info(1,x,y,d);
+        if(li.count==4 && li.openEnds>=1) score += SCORE_OPEN_FOUR/2;
+        else if(li.count==3 && li.openEnds==2) score += SCORE_OPEN_THREE;
+        else if(li.count==3 && li.openEnds==1) score += SCORE_BLOCKED_THREE/2;
+        else if(li.count==2 && li.openEnds==2) score += SCORE_OPEN_TWO/2;
+        quick1 += li.count*li.count;
+    }
+    for(int d=0;d<4;++d){
+        LineInfo li = tm.info(2,x,y,d);
+        if(li.count==4 && li.openEnds>=1) score += SCORE_OPEN_FOUR/2;
+        else if(li.count==3 && li.openEnds==2) score += SCORE_OPEN_THREE/2;
+        quick2 += li.count*li.count;
+    }
+    return score + quick1 + quick2/2;
+}
+
+bool genMoves(const int b[BOARD_SIZE][BOARD_SIZE], const ThreatMap& tm, int player,
+              std::vector<Move>& out, int radius, bool forced){
+    GOMOKU_PROFILE_SCOPE(PF_GEN_MOVES);
+    out.clear();
+    int minX, minY, maxX, maxY;
+    if(!candidateBounds(b, radius, minX, minY, maxX, maxY)){ out.push_back({BOARD_SIZE/2, BOARD_SIZE/2, 0}); return false; }
+
+    // 强制应对：成五点、活四点必然紧邻棋子，始终落在候选区域内
+    const int opp = (player==1)?2:1;
+    uint8_t ownMask=0, oppMask=0;
+    bool blockOpenFour=false;
+    if(forced){
+        if(tm.count(player, ThreatMap::T_FIVE)) ownMask = ThreatMap::T_FIVE;           // 一步成五
+        else if(tm.count(opp, ThreatMap::T_FIVE)) oppMask = ThreatMap::T_FIVE;         // 必须堵五
+        else if(tm.count(opp, ThreatMap::T_OPEN_FOUR)){                                // 对方有活四点：堵或冲四反击
+            ownMask = ThreatMap::T_FOUR;
+            blockOpenFour = true;
+        }
+    }
+    const bool pruned = ownMask || oppMask || blockOpenFour;
+
+    // 堵活四点：本方落子只会让对方的成五点减少，不会产生新的活四点，
+    // 所以合格的堵点必须让对方现有的每个活四点都失效。任一活四点只受其四条线上 4 格以内落子影响，
+    // 候选取第一个活四点及其邻域，再逐个验证对全部活四点的影响
+    bool block[BOARD_SIZE][BOARD_SIZE]{};
+    if(blockOpenFour){
+        std::vector<std::pair<int,int>> points;
+        for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
+            if(tm.flags(opp,i,j) & ThreatMap::T_OPEN_FOUR) points.push_back({i,j});
+        }
+        int tmp[BOARD_SIZE][BOARD_SIZE];
+        std::memcpy(tmp, b, sizeof(tmp));
+        auto blocksAll = [&](int mx, int my){
+            tmp[mx][my]=player;
+            bool ok=true;
+            for(auto [gx,gy]: points){
+                if(gx==mx && gy==my) continue;
+                uint8_t win[4];
+                for(int d=0;d<4;++d){ int v[11]; loadLine(tmp,gx,gy,d,5,v); win[d] = scanWindows(v,opp); }
+                if(threatFlags(win) & ThreatMap::T_OPEN_FOUR){ ok=false; break; }
+            }
+            tmp[mx][my]=0;
+            return ok;
+        };
+        auto [gx,gy] = points.front();
+        if(blocksAll(gx,gy)) block[gx][gy]=true;
+        for(int d=0;d<4;++d) for(int k=-4;k<=4;++k){
+            int nx=gx+k*THREAT_DIRS[d][0], ny=gy+k*THREAT_DIRS[d][1];
+            if(k==0 || !inBoard2(nx,ny) || b[nx][ny]!=0) continue;
+            if(blocksAll(nx,ny)) block[nx][ny]=true;
+        }
+    }
+
+    for(int i=minX;i<=maxX;++i){
+        for(int j=minY;j<=maxY;++j){
+            if(b[i][j]!=0) continue;
+            if(pruned && !(tm.flags(player,i,j) & ownMask) && !(tm.flags(opp,i,j) & oppMask) && !block[i][j]) continue;
+            out.push_back({i,j, scoreFromMap(tm,i,j)});
+        }
+    }
+    sortAndTrim(out);
+    return pruned;
+}
+
+static bool hasNeighbor(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y){
+    for(int dx=-1;dx<=1;++dx) for(int dy=-1;dy<=1;++dy){
+        if((dx||dy) && inBoard2(x+dx,y+dy) && b[x+dx][y+dy]!=0) return true;
+    }
+    return false;
+}
+
+bool genForcingMoves(const int b[BOARD_SIZE][BOARD_SIZE], int player, std::vector<Move>& out, bool& mustBlock, size_t maxBranch){
+    GOMOKU_PROFILE_SCOPE(PF_GEN_FORCING);
+    out.clear();
+    mustBlock=false;
+    const int opp = (player==1)?2:1;
+    static constexpr int DIRS[4][2]={{1,0},{0,1},{1,1},{1,-1}};
+    for(int i=0;i<BOARD_SIZE;++i){
+        for(int j=0;j<BOARD_SIZE;++j){
+            if(b[i][j]!=0 || !hasNeighbor(b,i,j)) continue;
+            if(makesFive(b,i,j,player)) return true;
+            if(makesFive(b,i,j,opp)){
+                if(!mustBlock){ out.clear(); mustBlock=true; }
+                out.push_back({i,j, SCORE_OPEN_FOUR*4});
+                continue;
+            }
+            if(mustBlock) continue;
+            int score=0;
+            for(auto &d:DIRS){
+                LineInfo li = lineInfoAfter(b,i,j,player,d[0],d[1]);
+                if(li.count==4 && li.openEnds==2) score += SCORE_OPEN_FOUR;      // 成活四
+                else if(li.count==4 && li.openEnds==1) score += SCORE_BLOCKED_FOUR; // 冲四
+            }
+            for(auto &d:DIRS){
+                LineInfo li = lineInfoAfter(b,i,j,opp,d[0],d[1]);
+                if(li.count==4 && li.openEnds>=1) score += SCORE_BLOCKED_FOUR/2; // 堵对方成四点
+            }
+            if(score>0) out.push_back({i,j,score});
+        }
+    }
+    std::ranges::sort(out, [](const Move&a,const Move&b){ return a.score>b.score; });
+    if(out.size()>maxBranch) out.resize(maxBranch);
+    return false;
+}
+
+bool genForcingMoves(const ThreatMap& tm, int player, std::vector<Move>& out, bool& mustBlock, size_t maxBranch){
+    GOMOKU_PROFILE_SCOPE(PF_GEN_FORCING);
+    out.clear();
+    mustBlock=false;
+    const int opp = (player==1)?2:1;
+    if(tm.count(player, ThreatMap::T_FIVE)) return true;
+    if(tm.count(opp, ThreatMap::T_FIVE)){
+        mustBlock=true;
+        for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
+            if(tm.flags(opp,i,j) & ThreatMap::T_FIVE) out.push_back({i,j, SCORE_OPEN_FOUR*4});
+        }
+    } else if(tm.count(player, ThreatMap::T_FOUR) || tm.count(opp, ThreatMap::T_FOUR)){
+        for(int i=0;i<BOARD_SIZE;++i) for(int j=0;j<BOARD_SIZE;++j){
+            if(!((tm.flags(player,i,j) | tm.flags(opp,i,j)) & ThreatMap::T_FOUR)) continue;
+            int score=0;
+            for(int d=0;d<4;++d){
+                LineInfo li = tm.info(player,i,j,d);
+                if(li.count==4 && li.openEnds==2) score += SCORE_OPEN_FOUR;
+                else if(li.count==4 && li.openEnds==1) score += SCORE_BLOCKED_FOUR;
+            }
+            for(int d=0;d<4;++d){
+                LineInfo li = tm.info(opp,i,j,d);
+                if(li.count==4 && li.openEnds>=1) score += SCORE_BLOCKED_FOUR/2;
+            }
+            if(score>0) out.push_back({i,j,score});
+        }
+    }
+    std::ranges::sort(out, [](const Move&a,const Move&b){ return a.score>b.score; });
+    if(out.size()>maxBranch) out.resize(maxBranch);
+    return false;
+}
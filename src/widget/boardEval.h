@@ -0,0 +1,109 @@
+#ifndef MY_APP_BOARDEVAL_H
+#define MY_APP_BOARDEVAL_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 棋盘评估原语（原 aibrain.cpp 内的静态函数）：
+// - 估值、棋型统计、走法生成、胜负检测与 Zobrist 哈希；
+// - 单独成模块，供 AI 搜索与 tools/ 下的基准测试、差分模糊测试共用。
+// 棋盘约定：0 空，1 黑，2 白；估值恒以黑方为正。
+
+inline constexpr int BOARD_SIZE = 15;
+// 模式权重
+inline constexpr int SCORE_FIVE = 1'000'000'0;      // 五连
+inline constexpr int SCORE_OPEN_FOUR = 1'000'000;    // 活四
+inline constexpr int SCORE_BLOCKED_FOUR = 300'000;   // 冲四
+inline constexpr int SCORE_OPEN_THREE = 15'000;      // 活三
+inline constexpr int SCORE_BLOCKED_THREE = 2'000;    // 眠三
+inline constexpr int SCORE_OPEN_TWO = 500;           // 活二
+inline constexpr int SCORE_BLOCKED_TWO = 100;        // 眠二
+
+// Zobrist 哈希表（固定种子，跨进程稳定）
+extern uint64_t ZOBRIST[BOARD_SIZE][BOARD_SIZE][3]; // 0 unused, 1 black, 2 white
+void initZobrist();
+uint64_t computeHash(const int b[BOARD_SIZE][BOARD_SIZE]);
+// Zobrist 表指纹：写入磁盘文件头，哈希种子变化后旧文件（缓存、局面索引）可据此作废
+uint64_t zobristFingerprint();
+
+// 走法结构（含排序用分数）
+struct Move { int x, y; int score; };
+
+// 行扫描帮助：统计一行模式出现次数
+struct PatternCount { int five=0, o4=0, b4=0, o3=0, b3=0, o2=0, b2=0; };
+
+struct LineInfo { int count; int openEnds; };
+
+inline bool inBoard2(int x,int y){ return x>=0 && x<BOARD_SIZE && y>=0 && y<BOARD_SIZE; }
+
+// 检测胜利：从 (x,y) 出发四个方向统计连续同色
+bool isWin(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y);
+bool isDraw(const int b[BOARD_SIZE][BOARD_SIZE]);
+
+// 在一条线（指针+步长）中统计给定颜色的各种模式
+void countPatternsLine(const int* start, int stride, int length, int color, PatternCount &pc);
+// 全盘棋型估值（黑优为正）
+int evaluate(const int b[BOARD_SIZE][BOARD_SIZE]);
+
+// 在不落子的情况下判断：若把 'color' 落在 (x,y) 是否形成五连
+bool makesFive(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int color);
+// 统计以 (x,y) 假设为 color 时，在方向(dx,dy)的连续数量及开放端数
+LineInfo lineInfoAfter(const int b[BOARD_SIZE][BOARD_SIZE], int x,int y,int color,int dx,int dy);
+
+// 增量威胁表：对每个空位、每种颜色、每个方向缓存 lineInfoAfter 的结果（供 genMoves 打分），
+// 以及按 5 / 6 格窗口扫描得到的棋型（供威胁判断，能识别跳四、跳三等间隔棋型），并汇总成威胁标记。
+// 落子或提子后调用 update()，只重算经过该点的四条线上受影响的空位；genMoves / genForcingMoves 可直接查表，
+// 不必对每个候选点重复扫描。
+class ThreatMap {
+public:
+    enum : uint8_t {
+        T_FIVE = 1,        // 落子即成五
+        T_FOUR = 2,        // 落子后出现成五点（冲四 / 活四，含跳四）
+        T_OPEN_FOUR = 4,   // 落子后出现两个以上成五点（活四或双四），对方只堵一处挡不住
+        T_OPEN_THREE = 8,  // 落子成活三（6 格窗口两端空、中间 4 格含 3 子，含跳三）
+    };
+
+    // 按整盘重建（搜索开始时调用一次）
+    void rebuild(const int b[BOARD_SIZE][BOARD_SIZE]);
+    // (x,y) 刚落子或提子后调用，b 为变化后的棋盘
+    void update(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y);
+
+    LineInfo info(int color, int x, int y, int dir) const {
+        uint8_t v = line_[color-1][x][y][dir];
+        return {v >> 2, v & 3};
+    }
+    uint8_t flags(int color, int x, int y) const { return flags_[color-1][x][y]; }
+    // 带有某个标记（单一位）的空位数，用于快速判断是否存在威胁
+    int count(int color, uint8_t flag) const { return counts_[color-1][std::countr_zero(flag)]; }
+
+    bool operator==(const ThreatMap&) const = default;
+
+private:
+    void refresh(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int dir);
+    // v 为该方向上以 (x,y) 为中心的 11 格（已读入的线缓冲）；lineChanged 为 false 时只重算窗口
+    void refresh(const int b[BOARD_SIZE][BOARD_SIZE], int x, int y, int dir, const int* v, bool lineChanged);
+
+    uint8_t line_[2][BOARD_SIZE][BOARD_SIZE][4]{};  // (count<<2)|openEnds，空位以外为 0
+    uint8_t window_[2][BOARD_SIZE][BOARD_SIZE][4]{}; // 窗口扫描结果，见 boardEval.cpp 的 scanWindows
+    uint8_t flags_[2][BOARD_SIZE][BOARD_SIZE]{};
+    int counts_[2][4]{};
+};
+
+// 候选走法生成：邻域内空位按启发分降序，最多 40 个
+void genMoves(const int b[BOARD_SIZE][BOARD_SIZE], std::vector<Move>& out, int radius);
+// 查表版本：打分与上面逐位一致；forced 为 true 且存在威胁时只返回强制应对——
+// 本方成五点 > 对方成五点（必堵）> 对方有活四点（活三 / 跳三 / 双四点）时，能消除其全部活四点的堵点与本方冲四。
+// 返回是否发生了强制裁剪
+bool genMoves(const int b[BOARD_SIZE][BOARD_SIZE], const ThreatMap& tm, int player,
+              std::vector<Move>& out, int radius, bool forced);
+// 生成强制着法：成五 / 堵五 / 冲四 / 堵四
+// 返回 true 表示 player 可一步成五（调用方直接判胜）；mustBlock 表示对方已有成五点，只保留堵点
+bool genForcingMoves(const int b[BOARD_SIZE][BOARD_SIZE], int player, std::vector<Move>& out,
+                     bool& mustBlock, size_t maxBranch);
+// 查表版本，结果与上面逐位一致
+bool genForcingMoves(const ThreatMap& tm, int player, std::vector<Move>& out,
+                     bool& mustBlock, size_t maxBranch);
+
+#endif //MY_APP_BOARDEVAL_H
@@ -33,9 +33,10 @@ public:
     int lastX() const { return lastMoveX; }
     int lastY() const { return lastMoveY; }
 
-private:
-    // 从最近一步出发的胜负检测（四方向局部扫描）
+    // 从 (x,y) 出发的胜负检测（四方向局部扫描）；只读查询，基准/差分测试也会直接调用
     bool checkWinFrom(int x, int y) const;
+
+private:
     // 是否已无空位（和棋）
     bool isBoardFull() const;
 
@@ -7,6 +7,8 @@
 
 #include "widget/gomokuLogic.h"
 #include "widget/aibrain.h"
+#include "widget/profile.h"
+#include "widget/searchCache.h"
 
 using namespace std;
 
@@ -33,7 +35,7 @@ std::pair<int, int> getRandomMove(const GomokuLogic& game) {
     return {-1, -1};
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     SetConsoleOutputCP(65001);
     setvbuf(stdout, NULL, _IONBF, 0);
 
@@ -41,6 +43,20 @@ int main() {
     // 保持你的 AI 参数不变
     AlphaBeta ai(1000, 10000, 1.414, true, 2);
 
+    // 可选持久化搜索缓存: --cache <path> [--cache-max <entries>]
+    SearchCache cache;
+    string cachePath;
+    size_t cacheMax = 1 << 20; // 16 字节/条，默认上限约 16 MB
+    for (int i = 1; i + 1 < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--cache") cachePath = argv[++i];
+        else if (arg == "--cache-max") cacheMax = stoull(argv[++i]);
+    }
+    if (!cachePath.empty()) {
+        cache.open(cachePath, cacheMax);
+        ai.setCache(&cache);
+    }
+
     while (true) {
         string line;
         if (!getline(cin, line)) break;
@@ -56,6 +72,7 @@ int main() {
                 isPvE = (mode == "PVE");
 
                 game.reset(); // 重置棋盘
+                cache.flush();
                 cout << "GAME_STARTED" << endl;
 
 
@@ -68,6 +85,7 @@ int main() {
         // --- 2. 重开 ---
         else if (command == "RESTART") {
             game.reset();
+            cache.flush();
             cout << "GAME_STARTED" << endl;
 
             if (isPvE) {
@@ -115,6 +133,52 @@ int main() {
                 }
             }
         }
+        // --- 4. 搜索统计 ---
+        else if (command == "STATS") {
+            const SearchStats& st = ai.lastStats();
+            cout << "STATS depth=" << st.depth << " nodes=" << st.nodes << " qnodes=" << st.qnodes
+                 << " lmr=" << st.lmrReductions << " lmr_research=" << st.lmrResearches
+                 << " futility=" << st.futilityPrunes << " cache_hits=" << st.cacheHits
+                 << " forced=" << st.forcedGens << endl;
+        }
+        // --- 5. 选择性搜索开关: SET_OPTION LMR|FUTILITY|FORCED ON|OFF ---
+        else if (command == "SET_OPTION") {
+            if (parts.size() < 3) continue;
+            SearchOptions opts = ai.options();
+            bool on = (parts[2] == "ON");
+            if (parts[1] == "LMR") opts.lateMoveReduction = on;
+            else if (parts[1] == "FUTILITY") opts.futilityPruning = on;
+            else if (parts[1] == "FORCED") opts.forcedMoves = on;
+            else continue;
+            ai.setOptions(opts);
+        }
+        // --- 6. 按节点 / 深度预算让 AI 走一步（确定性，可复现）: GO [nodes N] [depth D] ---
+        else if (command == "GO") {
+            if (game.state() != GomokuLogic::InProgress) continue;
+            SearchLimits limits;
+            for (size_t i = 1; i + 1 < parts.size(); i += 2) {
+                if (parts[i] == "nodes") limits.nodes = stoll(parts[i + 1]);
+                else if (parts[i] == "depth") limits.depth = stoi(parts[i + 1]);
+            }
+            cout << "AI_THINKING" << endl;
+            std::pair<int, int> aiMove = ai.getBestMove(game.getBoard(), limits);
+            if (!game.placePiece(aiMove.first, aiMove.second)) {
+                cout << "INVALID_MOVE" << endl;
+                continue;
+            }
+            cout << "MOVED " << aiMove.first << "," << aiMove.second << "," << game.getBoard()[aiMove.first][aiMove.second] << endl;
+            if (game.state() == GomokuLogic::WhiteWin) { cout << "WINNER WHITE" << endl; }
+            else if (game.state() == GomokuLogic::BlackWin) { cout << "WINNER BLACK" << endl; }
+            else if (game.state() == GomokuLogic::Draw) { cout << "WINNER DRAW" << endl; }
+        }
+        // --- 7. 剖析报告（需 GOMOKU_PROFILE 构建）: PROFILE_DUMP [prefix] ---
+        else if (command == "PROFILE_DUMP") {
+            const string prefix = (parts.size() >= 2) ? parts[1] : "gomoku_profile";
+            if (profileDump(prefix.c_str())) cout << "PROFILE_DUMPED " << prefix << endl;
+            else cout << "PROFILE_UNAVAILABLE" << endl;
+        }
     }
+    cache.flush();
+    profileDump("gomoku_profile");
     return 0;
 }
\ No newline at end of file
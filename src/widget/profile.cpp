@@ -0,0 +1,138 @@
+#include "profile.h"
+
+#ifdef GOMOKU_PROFILE
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static constexpr const char* PROFILE_NAMES[PF_COUNT] = {
+    "alphabeta", "quiescence", "tt_probe", "genMoves", "genForcingMoves", "evaluate", "isWin"
+};
+
+// 调用树节点：同一函数在不同调用路径下分别计时（用于折叠栈）
+struct ProfileNode {
+    int fn;
+    int parent;
+    long long calls = 0;
+    long long selfNs = 0;
+    std::vector<int> children;
+};
+
+// 按函数汇总；active 用于递归时只在最外层累计包含时间
+struct ProfileFuncTotal {
+    long long calls = 0;
+    long long inclusiveNs = 0;
+    long long exclusiveNs = 0;
+    int active = 0;
+};
+
+struct ProfileFrame {
+    int node;
+    std::chrono::steady_clock::time_point start;
+    long long childNs;
+};
+
+struct ProfileThread {
+    std::vector<ProfileNode> nodes{ProfileNode{-1, -1, 0, 0, {}}}; // 0 号为根
+    std::vector<ProfileFrame> stack;
+    ProfileFuncTotal totals[PF_COUNT];
+};
+
+// 线程状态登记后永不释放，dump 时可安全遍历（应在搜索空闲时调用）
+static std::mutex g_profileMutex;
+static std::vector<ProfileThread*> g_profileThreads;
+
+static ProfileThread& profileThread() {
+    thread_local ProfileThread* tl = [] {
+        auto* t = new ProfileThread();
+        std::lock_guard<std::mutex> lock(g_profileMutex);
+        g_profileThreads.push_back(t);
+        return t;
+    }();
+    return *tl;
+}
+
+ProfileScope::ProfileScope(ProfileFn fn) {
+    ProfileThread& t = profileThread();
+    int parent = t.stack.empty() ? 0 : t.stack.back().node;
+    int node = -1;
+    for (int c : t.nodes[parent].children) {
+        if (t.nodes[c].fn == fn) { node = c; break; }
+    }
+    if (node < 0) {
+        node = (int)t.nodes.size();
+        t.nodes.push_back(ProfileNode{fn, parent, 0, 0, {}});
+        t.nodes[parent].children.push_back(node);
+    }
+    t.totals[fn].active++;
+    t.stack.push_back({node, std::chrono::steady_clock::now(), 0});
+}
+
+ProfileScope::~ProfileScope() {
+    ProfileThread& t = profileThread();
+    ProfileFrame f = t.stack.back();
+    t.stack.pop_back();
+    long long elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - f.start).count();
+    long long self = elapsed - f.childNs;
+
+    ProfileNode& n = t.nodes[f.node];
+    n.calls++;
+    n.selfNs += self;
+    ProfileFuncTotal& tot = t.totals[n.fn];
+    tot.calls++;
+    tot.exclusiveNs += self;
+    if (--tot.active == 0) tot.inclusiveNs += elapsed;
+    if (!t.stack.empty()) t.stack.back().childNs += elapsed;
+}
+
+static void writeFolded(FILE* out, const ProfileThread& t, int node, std::string& path) {
+    const ProfileNode& n = t.nodes[node];
+    size_t len = path.size();
+    if (node != 0) {
+        if (!path.empty()) path += ';';
+        path += PROFILE_NAMES[n.fn];
+        long long us = n.selfNs / 1000;
+        if (us > 0) std::fprintf(out, "%s %lld\n", path.c_str(), us);
+    }
+    for (int c : n.children) writeFolded(out, t, c, path);
+    path.resize(len);
+}
+
+bool profileDump(const char* prefix) {
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    std::string base = prefix;
+
+    FILE* report = std::fopen((base + ".txt").c_str(), "w");
+    if (!report) return false;
+    ProfileFuncTotal sum[PF_COUNT];
+    for (const ProfileThread* t : g_profileThreads) {
+        for (int f = 0; f < PF_COUNT; ++f) {
+            sum[f].calls += t->totals[f].calls;
+            sum[f].inclusiveNs += t->totals[f].inclusiveNs;
+            sum[f].exclusiveNs += t->totals[f].exclusiveNs;
+        }
+    }
+    std::fprintf(report, "threads=%zu\n", g_profileThreads.size());
+    std::fprintf(report, "%-16s %12s %12s %12s %10s\n", "function", "calls", "incl_ms", "excl_ms", "excl_ns/call");
+    for (int f = 0; f < PF_COUNT; ++f) {
+        const ProfileFuncTotal& s = sum[f];
+        std::fprintf(report, "%-16s %12lld %12.3f %12.3f %10.1f\n", PROFILE_NAMES[f], s.calls,
+                     s.inclusiveNs / 1e6, s.exclusiveNs / 1e6, s.calls ? (double)s.exclusiveNs / s.calls : 0.0);
+    }
+    std::fclose(report);
+
+    FILE* folded = std::fopen((base + ".folded").c_str(), "w");
+    if (!folded) return false;
+    for (const ProfileThread* t : g_profileThreads) {
+        std::string path;
+        writeFolded(folded, *t, 0, path);
+    }
+    std::fclose(folded);
+    return true;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef MY_APP_PROFILE_H
+#define MY_APP_PROFILE_H
+
+// 热路径剖析（仅在 CMake 选项 GOMOKU_PROFILE=ON 时编译进来）：
+// - 在被测函数开头放置 GOMOKU_PROFILE_SCOPE(PF_xxx)，RAII 计时器记录调用次数与耗时；
+// - 计时数据累积在线程局部的调用树中，热路径上无锁；
+// - profileDump(prefix) 写出 <prefix>.txt（按函数的调用次数 / 包含 / 独占耗时）
+//   与 <prefix>.folded（折叠栈，可直接交给 flamegraph.pl）。
+// 选项关闭时宏展开为空，profileDump 直接返回 false，不产生任何开销。
+
+enum ProfileFn {
+    PF_ALPHABETA,
+    PF_QUIESCENCE,
+    PF_TT_PROBE,
+    PF_GEN_MOVES,
+    PF_GEN_FORCING,
+    PF_EVALUATE,
+    PF_IS_WIN,
+    PF_COUNT
+};
+
+#ifdef GOMOKU_PROFILE
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileFn fn);
+    ~ProfileScope();
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+// 汇总所有线程的计时并写出报告；成功返回 true
+bool profileDump(const char* prefix);
+
+#define GOMOKU_PROFILE_CONCAT2(a, b) a##b
+#define GOMOKU_PROFILE_CONCAT(a, b) GOMOKU_PROFILE_CONCAT2(a, b)
+#define GOMOKU_PROFILE_SCOPE(fn) ProfileScope GOMOKU_PROFILE_CONCAT(profileScope_, __LINE__)(fn)
+
+#else
+
+inline bool profileDump(const char*) { return false; }
+
+#define GOMOKU_PROFILE_SCOPE(fn) ((void)0)
+
+#endif
+
+#endif //MY_APP_PROFILE_H
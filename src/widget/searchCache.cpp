@@ -0,0 +1,178 @@
+#include "searchCache.h"
+#include "boardEval.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 文件头（32 字节，条目区紧随其后，8 字节对齐）
+struct CacheHeader {
+    char magic[8];          // "GMKCACHE"
+    uint32_t version;       // 格式或估值语义变化时递增
+    uint32_t entrySize;     // sizeof(CacheEntry)
+    uint64_t zobristCheck;  // Zobrist 表指纹，哈希种子变化后旧文件作废
+    uint64_t count;         // 条目数
+};
+static_assert(sizeof(CacheHeader) == 32, "CacheHeader must stay 32 bytes on disk");
+
+static constexpr char CACHE_MAGIC[8] = {'G','M','K','C','A','C','H','E'};
+static constexpr uint32_t CACHE_VERSION = 1;
+
+SearchCache::~SearchCache() {
+    unmap();
+}
+
+void SearchCache::open(const std::string& path, size_t maxEntries) {
+    unmap();
+    path_ = path;
+    maxEntries_ = maxEntries;
+    mapTried_ = false;
+    pending_.clear();
+}
+
+bool SearchCache::map() {
+    if (path_.empty()) return false;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(CacheHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(file); return false; }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    view_ = view;
+    viewSize_ = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CacheHeader)) { ::close(fd); return false; }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    view_ = view;
+    viewSize_ = (size_t)st.st_size;
+#endif
+
+    // 校验文件头：任何不匹配都视为空缓存，下次 flush 时覆盖
+    CacheHeader hdr;
+    std::memcpy(&hdr, view_, sizeof(hdr));
+    bool valid = std::memcmp(hdr.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0
+              && hdr.version == CACHE_VERSION
+              && hdr.entrySize == sizeof(CacheEntry)
+              && hdr.zobristCheck == zobristFingerprint()
+              && hdr.count <= (viewSize_ - sizeof(CacheHeader)) / sizeof(CacheEntry);
+    if (!valid) {
+        unmap();
+        return false;
+    }
+    entries_ = reinterpret_cast<const CacheEntry*>(static_cast<const char*>(view_) + sizeof(CacheHeader));
+    count_ = (size_t)hdr.count;
+    return true;
+}
+
+void SearchCache::unmap() {
+    if (view_) {
+#ifdef _WIN32
+        UnmapViewOfFile(view_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        munmap(view_, viewSize_);
+#endif
+    }
+    view_ = nullptr;
+    viewSize_ = 0;
+    entries_ = nullptr;
+    count_ = 0;
+}
+
+bool SearchCache::probe(uint64_t key, CacheEntry& out) {
+    if (path_.empty()) return false;
+    auto it = pending_.find(key);
+    if (it != pending_.end()) { out = it->second; return true; }
+    if (!mapTried_) { mapTried_ = true; map(); }
+    if (!entries_) return false;
+    const CacheEntry* end = entries_ + count_;
+    const CacheEntry* pos = std::lower_bound(entries_, end, key,
+                                             [](const CacheEntry& e, uint64_t k) { return e.key < k; });
+    if (pos == end || pos->key != key) return false;
+    out = *pos;
+    return true;
+}
+
+void SearchCache::record(uint64_t key, int value, int depth, int bestMove) {
+    if (path_.empty()) return;
+    CacheEntry e{key, (int32_t)value, (int16_t)depth,
+                 (uint8_t)((bestMove >= 0 && bestMove < BOARD_SIZE*BOARD_SIZE) ? bestMove : NO_MOVE), 0};
+    auto [it, inserted] = pending_.try_emplace(key, e);
+    if (!inserted && it->second.depth <= e.depth) it->second = e;
+}
+
+bool SearchCache::flush() {
+    if (path_.empty()) return false;
+    if (pending_.empty()) return true;
+    if (!mapTried_) { mapTried_ = true; map(); }
+
+    std::vector<CacheEntry> all(entries_, entries_ + count_);
+    all.reserve(count_ + pending_.size());
+    for (const auto& [key, e] : pending_) all.push_back(e);
+    unmap(); // Windows 下映射未释放时无法替换文件
+
+    // 同 key 只留最深的一条
+    std::sort(all.begin(), all.end(), [](const CacheEntry& a, const CacheEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.depth > b.depth;
+    });
+    all.erase(std::unique(all.begin(), all.end(),
+                          [](const CacheEntry& a, const CacheEntry& b) { return a.key == b.key; }),
+              all.end());
+    // 超出上限时保留深度最高的条目
+    if (all.size() > maxEntries_) {
+        std::nth_element(all.begin(), all.begin() + (std::ptrdiff_t)maxEntries_, all.end(),
+                         [](const CacheEntry& a, const CacheEntry& b) { return a.depth > b.depth; });
+        all.resize(maxEntries_);
+        std::sort(all.begin(), all.end(), [](const CacheEntry& a, const CacheEntry& b) { return a.key < b.key; });
+    }
+
+    // 先写临时文件再替换，避免中途崩溃留下半截文件
+    const std::string tmp = path_ + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    mapTried_ = false; // 无论成败，下次 probe 重新映射
+    if (!f) return false;
+    CacheHeader hdr{};
+    std::memcpy(hdr.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    hdr.version = CACHE_VERSION;
+    hdr.entrySize = sizeof(CacheEntry);
+    hdr.zobristCheck = zobristFingerprint();
+    hdr.count = all.size();
+    bool ok = std::fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    if (ok && !all.empty()) ok = std::fwrite(all.data(), sizeof(CacheEntry), all.size(), f) == all.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) { std::remove(tmp.c_str()); return false; }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path_, ec);
+    if (ec) { std::remove(tmp.c_str()); return false; }
+    pending_.clear();
+    return true;
+}
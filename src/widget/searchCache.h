@@ -0,0 +1,66 @@
+#ifndef MY_APP_SEARCHCACHE_H
+#define MY_APP_SEARCHCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// 持久化搜索缓存：把高深度的精确搜索结果保存到磁盘，进程重启后热启动。
+// 文件格式：CacheHeader + 按 key 升序排列的 CacheEntry 数组（二分查找）。
+// - open() 只记录路径，首次 probe() 时才 mmap（懒加载，不拖慢启动）；
+// - record() 把新结果放进内存待写表，flush() 与已映射条目合并、按深度截断到上限后整体重写；
+// - 头部带版本号与 Zobrist 校验值，格式或哈希表变化后旧文件自动作废。
+
+struct CacheEntry {
+    uint64_t key;      // Zobrist 哈希
+    int32_t value;     // 精确分（黑优为正）
+    int16_t depth;     // 剩余搜索深度
+    uint8_t bestMove;  // x*15+y，255 表示无
+    uint8_t reserved;
+};
+static_assert(sizeof(CacheEntry) == 16, "CacheEntry must stay 16 bytes on disk");
+
+class SearchCache {
+public:
+    static constexpr uint8_t NO_MOVE = 255;
+
+    SearchCache() = default;
+    ~SearchCache();
+    SearchCache(const SearchCache&) = delete;
+    SearchCache& operator=(const SearchCache&) = delete;
+
+    // 指定缓存文件与条目上限（文件不存在也可以，首次 flush 时创建）
+    void open(const std::string& path, size_t maxEntries);
+    bool isOpen() const { return !path_.empty(); }
+
+    // 按 key 查找：先查待写表，再查映射文件
+    bool probe(uint64_t key, CacheEntry& out);
+    // 记录一个精确结果，同一 key 只保留更深的
+    void record(uint64_t key, int value, int depth, int bestMove);
+    size_t pendingCount() const { return pending_.size(); }
+
+    // 合并待写条目并重写文件；成功返回 true
+    bool flush();
+
+private:
+    bool map();
+    void unmap();
+
+    std::string path_;
+    size_t maxEntries_ = 0;
+    bool mapTried_ = false;
+
+    const CacheEntry* entries_ = nullptr; // 指向映射区内的条目数组
+    size_t count_ = 0;
+    void* view_ = nullptr;
+    size_t viewSize_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+
+    std::unordered_map<uint64_t, CacheEntry> pending_;
+};
+
+#endif //MY_APP_SEARCHCACHE_H